@@ -8,6 +8,10 @@ pkg_check_modules(XINERAMA xinerama)
 pkg_check_modules(XEXT REQUIRED xext)
 pkg_check_modules(XFIXES REQUIRED xfixes)
 
+# for sending requests without waiting for each reply
+pkg_check_modules(XCB REQUIRED xcb)
+pkg_check_modules(X11XCB REQUIRED x11-xcb)
+
 # for transparency support
 pkg_check_modules(XRENDER REQUIRED xrender)
 
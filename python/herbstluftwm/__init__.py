@@ -2,7 +2,7 @@
 import shlex
 import subprocess
 from herbstluftwm.types import HlwmType
-from typing import List
+from typing import Dict, List
 """
 Python bindings for herbstluftwm. The central entity for communication
 with the herbstluftwm server is the Herbstluftwm class. See the example.py
@@ -75,6 +75,32 @@ class Herbstluftwm:
                 assert allowed_stderr.match(line)
         return proc
 
+    def get_attrs(self, paths: List[str]) -> Dict[str, str]:
+        """
+        query the plain string values of several attributes with a
+        single call. A path ending with a dot denotes all attributes
+        of the respective object. Returns a dict mapping attribute
+        paths to their values.
+        """
+        stdout = self.call(['get_attrs'] + paths).stdout
+        escapes = {'\\': '\\', 't': '\t', 'n': '\n'}
+        result = {}
+        for line in stdout.split('\n'):
+            if not line:
+                continue
+            path, escaped = line.split('\t', maxsplit=1)
+            value = ''
+            pos = 0
+            while pos < len(escaped):
+                if escaped[pos] == '\\' and pos + 1 < len(escaped):
+                    value += escapes.get(escaped[pos + 1], escaped[pos + 1])
+                    pos += 2
+                else:
+                    value += escaped[pos]
+                    pos += 1
+            result[path] = value
+        return result
+
     @property
     def attr(self) -> 'AttributeProxy':
         """return an attribute proxy"""
@@ -10,19 +10,34 @@ using std::stringstream;
 
 ArgList::ArgList(const ArgList::Container &c)
     : container_(make_shared<Container>(c))
+{ viewAll(); }
+
+ArgList::ArgList(ArgList::Container&& c)
+    : container_(make_shared<Container>(std::move(c)))
+{ viewAll(); }
+
+ArgList::ArgList(const ArgList &al)
+    : first_(al.first_)
+    , end_(al.end_)
+    , container_(al.container_)
 { reset(); }
 
-ArgList::ArgList(const ArgList &al) : container_(al.container_) { reset(); }
+ArgList::ArgList(const ArgList& other,
+                 Container::const_iterator from, Container::const_iterator to)
+    : first_(from)
+    , end_(to)
+    , container_(other.container_)
+{ reset(); }
 
 ArgList::ArgList(const string &s, char delim) {
     container_ = make_shared<Container>(split(s, delim));
-    reset();
+    viewAll();
 }
 
 ArgList::ArgList(Container::const_iterator from, Container::const_iterator to)
 {
     container_ = make_shared<Container>(from, to);
-    reset();
+    viewAll();
 }
 
 ArgList::Container ArgList::split(const string &s, char delim) {
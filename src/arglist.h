@@ -19,32 +19,33 @@ public:
     ArgList(Container::const_iterator from, Container::const_iterator to);
     ArgList(const ArgList &al);
     ArgList(const Container &c);
+    ArgList(Container&& c);
     // constructor that splits the given string
     ArgList(const std::string &s, char delim = '.');
     virtual ~ArgList() {}
 
     Container::const_iterator begin() const { return begin_; }
-    Container::const_iterator end() const { return container_->cend(); }
+    Container::const_iterator end() const { return end_; }
     const std::string& front() { return *begin_; }
-    const std::string& back() { return container_->back(); }
-    bool empty() const { return begin_ == container_->end(); }
+    const std::string& back() { return *(end_ - 1); }
+    bool empty() const { return begin_ == end_; }
     Container::size_type size() const {
-        return std::distance(begin_, container_->cend());
+        return std::distance(begin_, end_);
     }
 
     std::string join(char delim = '.');
 
     //! reset internal pointer to begin of arguments
     void reset() {
-        begin_ = container_->cbegin();
+        begin_ = first_;
         shiftedTooFar_ = false;
     }
     //! shift the internal pointer by amount
     void shift(Container::difference_type amount = 1) {
-        begin_ += std::min(amount, std::distance(begin_, container_->cend()));
+        begin_ += std::min(amount, std::distance(begin_, end_));
     }
     Container toVector() const {
-        return Container(begin_, container_->cend());
+        return Container(begin_, end_);
     }
     //! try read a value if possible
     virtual ArgList& operator>>(std::string& val);
@@ -55,6 +56,19 @@ public:
     }
 
 protected:
+    //! a view on the range [from, to) of the arguments of 'other'
+    //! that shares the container with 'other'
+    ArgList(const ArgList& other,
+            Container::const_iterator from, Container::const_iterator to);
+    //! let the view cover the entire container
+    void viewAll() {
+        first_ = container_->cbegin();
+        end_ = container_->cend();
+        reset();
+    }
+    //! the range [first_, end_) of container_ covered by this ArgList
+    Container::const_iterator first_;
+    Container::const_iterator end_;
     //! shift state pointing into container_
     Container::const_iterator begin_;
     //! indicator that we attempted to shift too far (shift is at end())
@@ -0,0 +1,32 @@
+#include "attributepath.h"
+
+#include "object.h"
+
+using std::string;
+
+AttributePath::AttributePath(const string& path)
+    : path_(path)
+{
+    auto split = Object::splitPath(path);
+    objectPath_ = split.first.toVector();
+    attributeName_ = split.second;
+}
+
+Attribute* AttributePath::resolve(Object& root)
+{
+    if (cached_ && generation_ == Object::treeGeneration()) {
+        return attribute_;
+    }
+    bool dynamic = false;
+    Object* owner = &root;
+    for (const auto& name : objectPath_) {
+        owner = owner->child(name, dynamic);
+        if (!owner) {
+            break;
+        }
+    }
+    attribute_ = owner ? owner->attribute(attributeName_) : nullptr;
+    cached_ = !dynamic;
+    generation_ = Object::treeGeneration();
+    return attribute_;
+}
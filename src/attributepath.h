@@ -0,0 +1,34 @@
+#ifndef __HERBST_ATTRIBUTEPATH_H_
+#define __HERBST_ATTRIBUTEPATH_H_
+
+#include <string>
+#include <vector>
+
+class Attribute;
+class Object;
+
+/**
+ * @brief A precompiled path to an attribute in the object tree.
+ *
+ * The path is split only once and the attribute it resolves to is
+ * remembered as long as the object tree does not change structurally
+ * (see Object::treeGeneration()). Paths that pass through a dynamic
+ * child are resolved again on every access, because a dynamic child
+ * may change without notice.
+ */
+class AttributePath {
+public:
+    AttributePath(const std::string& path);
+    //! the attribute the path currently points to, or nullptr
+    Attribute* resolve(Object& root);
+    const std::string& str() const { return path_; }
+private:
+    std::string path_;
+    std::vector<std::string> objectPath_;
+    std::string attributeName_;
+    Attribute* attribute_ = nullptr;
+    bool cached_ = false;
+    unsigned long generation_ = 0;
+};
+
+#endif
@@ -1,7 +1,9 @@
 #include "client.h"
 
+#include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <unistd.h>
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
@@ -9,6 +11,7 @@
 #include "clientmanager.h"
 #include "decoration.h"
 #include "ewmh.h"
+#include "floatingindex.h"
 #include "frametree.h"
 #include "globals.h"
 #include "hook.h"
@@ -55,8 +58,10 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     , ewmhnotify_(this, "ewmhnotify", true)
     , sizehints_floating_(this, "sizehints_floating", true)
     , sizehints_tiling_(this, "sizehints_tiling", false)
-    , window_class_(this, "class", &Client::getWindowClass)
-    , window_instance_(this, "instance", &Client::getWindowInstance)
+    , window_class_(this, "class", "")
+    , window_instance_(this, "instance", "")
+    , window_role_(this, "window_role", "")
+    , window_type_(this, "window_type", "")
     , content_geometry_(this, "content_geometry", {})
     , decoration_geometry_(this, "decoration_geometry", &Client::decorationGeometry)
     , manager(cm)
@@ -131,6 +136,9 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     pid_.setDoc("the process id of it (-1 if unset).");
     window_class_.setDoc("the class of it (second entry in WM_CLASS)");
     window_instance_.setDoc("the instance of it (first entry in WM_CLASS)");
+    window_role_.setDoc("its WM_WINDOW_ROLE (empty if unset)");
+    window_type_.setDoc("the first entry of its _NET_WM_WINDOW_TYPE "
+                        "if it is a known window type, and empty otherwise");
     fullscreen_.setDoc(
                 "whether this client covers all other "
                 "windows and panels on its monitor.");
@@ -172,16 +180,35 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
 }
 
 void Client::init_from_X() {
-    // treat wanted coordinates as floating coords
+    // send the requests first, such that we wait only once for the replies
     auto root = Root::get();
-    auto globalGeometry = root->X.windowSize(window_);
-    float_size_ = root->monitors->interpretGlobalGeometry(globalGeometry);
-    last_size_ = float_size_;
+    auto globalGeometry = root->X.windowSizeAsync(window_);
+    auto pid = root->X.getWindowProperty32Async(window_, root->X.atom("_NET_WM_PID"), XA_CARDINAL);
+    auto netWmName = root->X.getWindowPropertyAsync(window_, ewmh.netatom(NetWmName));
+    auto wmName = root->X.getWindowPropertyAsync(window_, XA_WM_NAME);
+    auto classHint = root->X.getClassHintAsync(window_);
+    auto role = root->X.getWindowPropertyAsync(window_, root->X.atom("WM_WINDOW_ROLE"));
+    auto windowType = root->X.getWindowProperty32Async(
+                window_, ewmh.netatom(NetWmWindowType), XA_ATOM);
 
-    pid_ = Root::get()->X.windowPid(window_);
-    pgid_ = Root::get()->X.windowPgid(window_);
+    // treat wanted coordinates as floating coords
+    float_size_ = root->monitors->interpretGlobalGeometry(globalGeometry.get());
+    last_size_ = float_size_;
 
-    update_title();
+    // the properties that are kept up to date by propertyChanged()
+    setPid(pid.get());
+    setClassHint(classHint.get());
+    setWindowRole(role.get());
+    setWindowType(windowType.get());
+
+    lastTitleUpdate_ = std::chrono::steady_clock::now();
+    // the same as update_title(), but the client is not focused yet.
+    // If there is a _NET_WM_NAME, then the reply for WM_NAME is discarded
+    if (netWmName.get().has_value()) {
+        title_ = netWmName.get().value();
+    } else {
+        title_ = wmName.get().value_or("");
+    }
     readWmHints();
     updatesizehints();
 }
@@ -206,10 +233,7 @@ void Client::make_full_client() {
         XUnmapWindow(X_.display(), window_);
     }
     // get events from window
-    XSelectInput(X_.display(), dec->decorationWindow(), (EnterWindowMask | LeaveWindowMask |
-                            ButtonPressMask | ButtonReleaseMask |
-                            ExposureMask |
-                            SubstructureRedirectMask | FocusChangeMask));
+    dec->updateResizeAreaMode();
     XSelectInput(X_.display(), window_,
                             StructureNotifyMask|FocusChangeMask
                             |EnterWindowMask|PropertyChangeMask);
@@ -224,7 +248,13 @@ void Client::listen_for_events() {
 }
 
 void Client::setTag(HSTag *tag) {
+    if (tag_) {
+        tag_->floatingIndex().invalidate();
+    }
     tag_ = tag;
+    if (tag_) {
+        tag_->floatingIndex().invalidate();
+    }
     ewmh.windowUpdateTag(window_, tag);
 }
 
@@ -550,13 +580,14 @@ void Client::set_visible(bool visible) {
         /* Grab the server to make sure that the frame window is mapped before
            the client gets its MapNotify, i.e. to make sure the client is
            _visible_ when it gets MapNotify. */
-        XGrabServer(X_.display());
+        X_.grabServer();
         ewmh.windowUpdateWmState(this->window_, WmState::WSNormalState);
         XMapWindow(X_.display(), this->window_);
         if (decorated_()) {
+            this->dec->prepareMap();
             XMapWindow(X_.display(), this->dec->decorationWindow());
         }
-        XUngrabServer(X_.display());
+        X_.ungrabServer();
     } else {
         /* we unmap the client itself so that we can get MapRequest
            events, and because the ICCCM tells us to! */
@@ -568,6 +599,9 @@ void Client::set_visible(bool visible) {
         this->ignore_unmaps_++;
     }
     this->visible_ = visible;
+    if (tag_) {
+        tag_->floatingIndex().invalidate();
+    }
 }
 
 void Client::urgencyAttributeChanged(bool state)
@@ -624,6 +658,7 @@ void Client::readWmHints(bool forceNotUrgent) {
 }
 
 void Client::update_title() {
+    lastTitleUpdate_ = std::chrono::steady_clock::now();
     string newName = ewmh.getWindowTitle(window_);
     bool changed = title_() != newName;
     title_ = newName;
@@ -665,6 +700,7 @@ void Client::fixParentWindow(bool decorated)
         XUnmapWindow(X_.display(), dec->decorationWindow());
     } else {
         if (visible_()) {
+            dec->prepareMap();
             XMapWindow(X_.display(), dec->decorationWindow());
         }
         XReparentWindow(X_.display(), window_, dec->decorationWindow(), 40, 40);
@@ -679,14 +715,54 @@ Rectangle Client::decorationGeometry()
     return dec->last_outer();
 }
 
-string Client::getWindowClass()
+void Client::setClassHint(const pair<string, string>& classHint)
 {
-    return ewmh.X().getClass(window_);
+    window_instance_ = classHint.first;
+    window_class_ = classHint.second;
 }
 
-string Client::getWindowInstance()
+void Client::setWindowRole(const std::experimental::optional<string>& role)
 {
-    return ewmh.X().getInstance(window_);
+    hasWindowRole_ = role.has_value();
+    window_role_ = role.value_or("");
+}
+
+void Client::setWindowType(const std::experimental::optional<vector<unsigned long>>& windowTypes)
+{
+    vector<Atom> atoms;
+    if (windowTypes.has_value()) {
+        atoms.assign(windowTypes.value().begin(), windowTypes.value().end());
+    }
+    windowType_ = ewmh.windowTypeFromAtoms(atoms);
+    window_type_ = (windowType_ < 0) ? "" : ewmh.netatomName(windowType_);
+}
+
+void Client::setPid(const std::experimental::optional<vector<unsigned long>>& pid)
+{
+    if (pid.has_value() && !pid.value().empty()) {
+        pid_ = static_cast<int>(pid.value()[0]);
+        pgid_ = getpgid(pid_());
+    } else {
+        pid_ = -1;
+        pgid_ = -1;
+    }
+}
+
+/**
+ * @brief re-read the cached window properties when the
+ * client changes one of them
+ */
+void Client::propertyChanged(Atom property)
+{
+    if (property == XA_WM_CLASS) {
+        setClassHint(X_.getClassHintAsync(window_).get());
+    } else if (property == X_.atom("WM_WINDOW_ROLE")) {
+        setWindowRole(X_.getWindowPropertyAsync(window_, property).get());
+    } else if (property == ewmh.netatom(NetWmWindowType)) {
+        setWindowType(X_.getWindowProperty32Async(window_, property, XA_ATOM).get());
+    } else if (property == X_.atom("_NET_WM_PID")) {
+        setPid(X_.getWindowProperty32Async(window_, property, XA_CARDINAL).get());
+    }
 }
 
 FrameLeaf* Client::parentFrame()
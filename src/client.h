@@ -3,12 +3,14 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <chrono>
 
 #include "attribute_.h"
 #include "child.h"
 #include "commandio.h"
 #include "converter.h"
 #include "object.h"
+#include "optional.h"
 #include "rectangle.h"
 #include "regexstr.h"
 #include "x11-types.h"
@@ -47,6 +49,8 @@ public:
     int         ignore_unmaps_ = 0;  // Ignore one unmap for each reparenting
                                 // action, because reparenting creates an unmap
                                 // notify event
+    //! the last time when the title was read
+    std::chrono::steady_clock::time_point lastTitleUpdate_;
     //! the last time when minimized_ was changed (with discrete time ticks).
     long long int minimizedLastChange_ = 0;
     // for size hints; 0 means 'unset'
@@ -84,8 +88,14 @@ public:
     Attribute_<bool> ewmhnotify_; // send ewmh-notifications for this client
     Attribute_<bool> sizehints_floating_;  // respect size hints regarding this client in floating mode
     Attribute_<bool> sizehints_tiling_;  // respect size hints regarding this client in tiling mode
-    DynAttribute_<std::string> window_class_;
-    DynAttribute_<std::string> window_instance_;
+    Attribute_<std::string> window_class_;
+    Attribute_<std::string> window_instance_;
+    Attribute_<std::string> window_role_;
+    Attribute_<std::string> window_type_;
+    //! the _NET_WM_WINDOW_TYPE as index of the net atoms or -1
+    int windowType_ = -1;
+    //! whether the window has a WM_WINDOW_ROLE at all
+    bool hasWindowRole_ = false;
     Attribute_<Rectangle> content_geometry_;
     DynAttribute_<Rectangle> decoration_geometry_;
 
@@ -116,6 +126,8 @@ public:
     void set_urgent(bool state);
     void readWmHints(bool forceNotUrgent = false);
     void update_title();
+    //! update the cached window properties if the property is one of them
+    void propertyChanged(Atom property);
     void raise();
     void lower();
 
@@ -139,8 +151,10 @@ private:
     void redraw();
     void redrawRelevantTabBars();
     Rectangle decorationGeometry();
-    std::string getWindowClass();
-    std::string getWindowInstance();
+    void setClassHint(const std::pair<std::string, std::string>& classHint);
+    void setWindowRole(const std::experimental::optional<std::string>& role);
+    void setWindowType(const std::experimental::optional<std::vector<unsigned long>>& windowTypes);
+    void setPid(const std::experimental::optional<std::vector<unsigned long>>& pid);
     std::string triggerRelayoutMonitor();
     FrameLeaf* parentFrame();
     void requestRedraw();
@@ -1,5 +1,6 @@
 #include "clientmanager.h"
 
+#include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <algorithm>
 #include <iostream>
@@ -17,6 +18,7 @@
 #include "mousemanager.h"
 #include "root.h"
 #include "rulemanager.h"
+#include "settings.h"
 #include "stack.h"
 #include "tag.h"
 #include "tagmanager.h"
@@ -68,6 +70,11 @@ void ClientManager::injectDependencies(Settings* s, Theme* t, Ewmh* e) {
     theme = t;
     ewmh = e;
     X_ = &e->X();
+    settings->decoration_resize_windows.changed().connect([this]() {
+        for (auto c : clients_) {
+            c.second->dec->updateResizeAreaMode();
+        }
+    });
 }
 
 string ClientManager::str(Client* client)
@@ -149,8 +156,14 @@ void ClientManager::completeEntries(Completion& complete)
     complete.full("urgent");
     complete.full("last-minimized");
     complete.full("longest-minimized");
-    for (const auto& it : clients_) {
-        complete.full(Converter<WindowID>::str(it.first));
+    // the clients are the children of the client manager, named by
+    // their window id. So only look at the ones matching the needle
+    auto range = complete.matchingKeys(children_);
+    for (auto it = range.first; it != range.second; it++) {
+        // skip the links 'focus' and 'dragged'
+        if (Completion::prefixOf("0x", it->first)) {
+            complete.full(it->first);
+        }
     }
 }
 
@@ -195,13 +208,20 @@ Client* ClientManager::manage_client(Window win, bool visible_already, bool forc
         return nullptr;
     }
 
+    // send the request for the default rules already, such that it
+    // is answered together with the requests of the client initialization
+    auto transientFor = X_->getWindowProperty32Async(
+                win, XA_WM_TRANSIENT_FOR, XA_WINDOW);
+
     // init client
     auto client = new Client(win, visible_already, *this);
     client->listen_for_events();
     Monitor* m = get_current_monitor();
 
     // apply rules
-    ClientChanges changes = applyDefaultRules(client->window_);
+    bool isTransient =
+        transientFor.get().has_value() && !transientFor.get().value().empty();
+    ClientChanges changes = applyDefaultRules(client->windowType_, isTransient);
     if (additionalRules) {
         additionalRules(changes);
     }
@@ -300,10 +320,9 @@ Client* ClientManager::manage_client(Window win, bool visible_already, bool forc
 
 //! apply some built in rules that reflect the EWMH specification
 //! and regarding sensible single-window floating settings
-ClientChanges ClientManager::applyDefaultRules(Window win)
+ClientChanges ClientManager::applyDefaultRules(int windowType, bool isTransient)
 {
     ClientChanges changes;
-    const int windowType = ewmh->getWindowType(win);
     vector<int> unmanaged= {
         NetWmWindowTypeDesktop,
         NetWmWindowTypeDock,
@@ -330,7 +349,7 @@ ClientChanges ClientManager::applyDefaultRules(Window win)
     {
         changes.floating = True;
     }
-    if (X_->getTransientForHint(win).has_value()) {
+    if (isTransient) {
         changes.floating = true;
     }
     return changes;
@@ -63,7 +63,8 @@ public:
     // adds a new client to list of managed client windows
     Client* manage_client(Window win, bool visible_already, bool force_unmanage,
                           std::function<void(ClientChanges&)> additionalRules = {});
-    ClientChanges applyDefaultRules(Window win);
+    //! the changes given by the window type and the WM_TRANSIENT_FOR hint
+    ClientChanges applyDefaultRules(int windowType, bool isTransient);
 
     int applyRulesCmd(Input input, Output output);
     int applyRules(Client* client, Output output, bool changeFocus = true);
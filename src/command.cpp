@@ -56,6 +56,10 @@ int CommandTable::callCommand(Input args, Output out) const {
         out.error() << "error: Command \"" << args.command() << "\" not found" << endl;
         return HERBST_COMMAND_NOT_FOUND;
     }
+    if (out.command() == args.command()) {
+        // the channels already carry the right command name
+        return cmd->second(args, out);
+    }
     // new channels object to have the command name updated
     OutputChannels channels(args.command(), out.output(), out.error());
     return cmd->second(args, channels);
@@ -87,6 +91,15 @@ bool Commands::commandExists(const string& commandName)
     return command_table->find(commandName) != command_table->end();
 }
 
+bool Commands::replyIsDeferred(const string& commandName)
+{
+    if (!command_table) {
+        return false;
+    }
+    auto it = command_table->find(commandName);
+    return it != command_table->end() && it->second.replyIsDeferred();
+}
+
 shared_ptr<const CommandTable> Commands::get() {
     if (!command_table) {
         throw std::logic_error("CommandTable not initialized, but get() called.");
@@ -97,8 +110,9 @@ shared_ptr<const CommandTable> Commands::get() {
 void Commands::complete(Completion& completion) {
     auto commandTable = Commands::get();
     if (completion == 0) {
-        for (const auto& cmd : *commandTable) {
-            completion.full(cmd.first);
+        auto range = completion.matchingKeys(commandTable->names());
+        for (auto it = range.first; it != range.second; it++) {
+            completion.full(*it);
         }
     } else {
         auto it = commandTable->find(completion[0]);
@@ -2,6 +2,7 @@
 #define __HERBSTLUFT_COMMAND_H_
 
 #include <functional>
+#include <set>
 #include <string>
 #include <unordered_map>
 
@@ -110,6 +111,12 @@ public:
 
     bool hasCompletion() const { return (bool)completion_; }
     void complete(Completion& completion) const;
+    /** Mark the command as possibly slow: ipc calls of it are run
+     * from the main loop's work queue and answered later, such
+     * that they do not delay the handling of X events.
+     */
+    CommandBinding& deferReply() { deferReply_ = true; return *this; }
+    bool replyIsDeferred() const { return deferReply_; }
 
     /** Call the stored command */
     int operator()(Input args, Output out) const { return command(args, out); }
@@ -122,6 +129,7 @@ private:
 
     std::function<int(Input, Output)> command;
     std::function<void(Completion&)>  completion_;
+    bool deferReply_ = false;
 };
 
 class CommandTable {
@@ -129,15 +137,23 @@ class CommandTable {
 
 public:
     CommandTable(std::initializer_list<Container::value_type> values)
-        : map(values) {}
+        : map(values)
+    {
+        for (const auto& it : map) {
+            names_.insert(it.first);
+        }
+    }
 
     int callCommand(Input args, Output out) const;
 
     Container::const_iterator begin() const { return map.cbegin(); }
     Container::const_iterator end() const { return map.cend(); }
     Container::const_iterator find(const std::string& str) const { return map.find(str); }
+    //! the command names in sorted order, e.g. for the completion
+    const std::set<std::string>& names() const { return names_; }
 private:
     Container map;
+    std::set<std::string> names_;
 };
 
 namespace Commands {
@@ -145,6 +161,8 @@ namespace Commands {
     /* Call the command args[0] */
     int call(Input args, Output out);
     bool commandExists(const std::string& commandName);
+    //! whether ipc calls of the command are answered later
+    bool replyIsDeferred(const std::string& commandName);
     void complete(Completion& completion);
     std::shared_ptr<const CommandTable> get();
 }
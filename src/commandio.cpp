@@ -8,6 +8,20 @@
 using std::string;
 using std::endl;
 
+StringOutputBuffer::int_type StringOutputBuffer::overflow(int_type ch)
+{
+    if (ch != traits_type::eof()) {
+        target_.push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize StringOutputBuffer::xsputn(const char* str, std::streamsize count)
+{
+    target_.append(str, static_cast<size_t>(count));
+    return count;
+}
+
 Input &Input::operator>>(string &val)
 {
     ArgList::operator>>(val);
@@ -21,11 +35,31 @@ Input Input::fromHere()
         return {{}, {}};
     }
 
-    return Input(*(begin()), Container(begin() + 1, end()));
+    return Input(*(begin()), *this, begin() + 1, end());
 }
 
 void Input::replace(const string &from, const string &to)
 {
+    bool found = *command_ == from;
+    for (auto it = first_; !found && it != end_; it++) {
+        found = *it == from;
+    }
+    if (!found) {
+        // nothing to replace, so avoid copying shared arguments
+        return;
+    }
+    // copy the arguments and the command name if they
+    // are shared with other Input objects
+    if (container_.use_count() > 1) {
+        auto shifted = begin_ - first_;
+        container_ = std::make_shared<Container>(first_, end_);
+        first_ = container_->cbegin();
+        end_ = container_->cend();
+        begin_ = first_ + shifted;
+    }
+    if (command_.use_count() > 1) {
+        command_ = std::make_shared<string>(*command_);
+    }
     for (auto &v : *container_) {
         if (v == from) {
             v = to;
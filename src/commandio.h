@@ -4,6 +4,9 @@
  * of commands
  */
 
+#include <streambuf>
+#include <string>
+
 #include "arglist.h"
 
 class Completion;
@@ -65,6 +68,23 @@ private:
 
 using Output = OutputChannels&;
 
+/**
+ * @brief A stream buffer that appends everything written to it to the
+ * given string. In contrast to std::ostringstream, the string can be
+ * reused for further output without giving up its capacity.
+ */
+class StringOutputBuffer : public std::streambuf {
+public:
+    StringOutputBuffer(std::string& target)
+        : target_(target)
+    {}
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* str, std::streamsize count) override;
+private:
+    std::string& target_;
+};
+
 /** The Input for a command consists of a command name
  * (known as argv[0] in a C main()) and of arguments (argv[1] up to
  * argv[argc] in a C main()).
@@ -82,12 +102,23 @@ public:
     Input(const std::string command, const Container &c = {})
         : ArgList(c), command_(std::make_shared<std::string>(command)) {}
 
+    Input(const std::string command, Container&& c)
+        : ArgList(std::move(c)), command_(std::make_shared<std::string>(command)) {}
+
     Input(const std::string command, Container::const_iterator from, Container::const_iterator to)
         : ArgList(from, to), command_(std::make_shared<std::string>(command)) {}
 
-    //! create a new Input but drop already parsed arguments
+    //! create a new Input but drop already parsed arguments.
+    //! The arguments are shared with 'other' until one of the
+    //! two is modified by replace().
     Input(const Input& other)
-        : ArgList(other.toVector()), command_(other.command_) {}
+        : ArgList(other, other.begin(), other.end()), command_(other.command_) {}
+
+    //! create an Input for the range [from, to) of the arguments of 'other',
+    //! sharing the arguments with 'other'
+    Input(const std::string& command, const Input& other,
+          Container::const_iterator from, Container::const_iterator to)
+        : ArgList(other, from, to), command_(std::make_shared<std::string>(command)) {}
 
     const std::string& command() const { return *command_; }
 
@@ -8,7 +8,9 @@
 #include "utils.h"
 
 using std::function;
+using std::pair;
 using std::string;
+using std::vector;
 
 /** Construct a completion context
  *
@@ -38,8 +40,47 @@ Completion::Completion(const Completion& other)
 void Completion::operator=(const Completion& other) {
 }
 
+//! whether the needle is a prefix of the word with prepend_ prepended
+bool Completion::matches(const string& word) const {
+    if (needle_.size() <= prepend_.size()) {
+        return prefixOf(needle_, prepend_);
+    }
+    // compare the remainder of the needle without copying the word
+    size_t remainder = needle_.size() - prepend_.size();
+    return prefixOf(prepend_, needle_)
+        && remainder <= word.size()
+        && word.compare(0, remainder, needle_, prepend_.size(), remainder) == 0;
+}
+
+bool Completion::keyNeedle(const string& keyPrefix, string& keyNeedle) const {
+    string word = prepend_ + keyPrefix;
+    if (prefixOf(word, needle_)) {
+        keyNeedle = needle_.substr(word.size());
+        return true;
+    }
+    // otherwise, all keys match if the needle is a prefix of word
+    keyNeedle = "";
+    return prefixOf(needle_, word);
+}
+
+pair<vector<string>::const_iterator, vector<string>::const_iterator>
+    Completion::matchingKeys(const vector<string>& sortedItems,
+                             const string& keyPrefix) const
+{
+    string prefix;
+    if (!keyNeedle(keyPrefix, prefix)) {
+        return { sortedItems.end(), sortedItems.end() };
+    }
+    auto first = std::lower_bound(sortedItems.begin(), sortedItems.end(), prefix);
+    auto last = first;
+    while (last != sortedItems.end() && prefixOf(prefix, *last)) {
+        last++;
+    }
+    return { first, last };
+}
+
 void Completion::full(const string& word) {
-    if (prefixOf(needle_, prepend_ + word)) {
+    if (matches(word)) {
         entryCount_++;
         output_ << escape(prepend_ + word) << (shellOutput_ ? " \n" : "\n");
         // std::cout << "add " << word << endl;
@@ -75,12 +116,15 @@ bool Completion::noParameterExpected() const {
 
 bool Completion::prefixOf(const string& shorter, const string& longer)
 {
+    if (shorter.size() > longer.size()) {
+        return false;
+    }
     auto res = std::mismatch(shorter.begin(), shorter.end(), longer.begin());
     return res.first == shorter.end();
 }
 
 void Completion::partial(const string& word) {
-    if (prefixOf(needle_, prepend_ + word)) {
+    if (matches(word)) {
         // partial completions never end with a space, regardless of
         // shellOutput mode
         output_ << escape(prepend_ + word) << "\n";
@@ -2,6 +2,9 @@
 #define HLWM_COMPLETION
 
 #include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "arglist.h"
 #include "commandio.h"
@@ -68,6 +71,38 @@ public:
 
     static bool prefixOf(const std::string& shorter, const std::string& longer);
     const std::string& needle() const;
+
+    /** Compute the prefix 'keyNeedle' that a key must have such that
+     * full(keyPrefix + key) or partial(keyPrefix + key) matches the needle.
+     * Returns false if there is no such key.
+     */
+    bool keyNeedle(const std::string& keyPrefix, std::string& keyNeedle) const;
+
+    /** The range of entries in the sorted container 'items' (a std::map or
+     * std::set with string keys) whose key, when passed with the given
+     * 'keyPrefix' to full() or partial(), matches the needle. This avoids
+     * enumerating all entries of large containers on every completion.
+     */
+    template<typename Sorted>
+    std::pair<typename Sorted::const_iterator, typename Sorted::const_iterator>
+        matchingKeys(const Sorted& items, const std::string& keyPrefix = {}) const
+    {
+        std::string prefix;
+        if (!keyNeedle(keyPrefix, prefix)) {
+            return { items.end(), items.end() };
+        }
+        auto first = items.lower_bound(prefix);
+        auto last = first;
+        while (last != items.end() && prefixOf(prefix, keyOf(*last))) {
+            last++;
+        }
+        return { first, last };
+    }
+    //! the same for a sorted vector of strings
+    std::pair<std::vector<std::string>::const_iterator,
+              std::vector<std::string>::const_iterator>
+        matchingKeys(const std::vector<std::string>& sortedItems,
+                     const std::string& keyPrefix = {}) const;
     size_t needleIndex() const { return index_; };
 
     /** Grants access to private members as long as Commands::complete is still
@@ -98,6 +133,12 @@ private:
 
     Completion shifted(size_t offset) const;
     std::string escape(const std::string& str);
+    bool matches(const std::string& word) const;
+    static const std::string& keyOf(const std::string& key) { return key; }
+    template<typename T>
+    static const std::string& keyOf(const std::pair<const std::string, T>& entry) {
+        return entry.first;
+    }
 
     ArgList args_;
     size_t index_;
@@ -10,9 +10,11 @@
 
 #include "client.h"
 #include "ewmh.h"
+#include "floatingindex.h"
 #include "font.h"
 #include "fontdata.h"
 #include "settings.h"
+#include "tag.h"
 #include "theme.h"
 #include "utils.h"
 #include "xconnection.h"
@@ -112,27 +114,132 @@ void Decoration::createWindow() {
     dec->last_actual_rect.x -= dec->last_outer_rect.x;
     dec->last_actual_rect.y -= dec->last_outer_rect.y;
     decwin2client[decwin] = client_;
+    // the resizeArea windows and the pixmap are only created
+    // once the client is shown, see prepareMap()
 
+    // set wm_class for window
+    XClassHint *hint = XAllocClassHint();
+    hint->res_name = (char*)HERBST_DECORATION_CLASS;
+    hint->res_class = (char*)HERBST_DECORATION_CLASS;
+    XSetClassHint(display, dec->decwin, hint);
+    XFree(hint);
+}
+
+/**
+ * @brief create the resizeArea windows, if this has not happened yet.
+ * They are placed according to the current outline.
+ */
+void Decoration::createResizeAreas()
+{
+    if (resizeArea[0]) {
+        return;
+    }
+    XConnection& xcon = xconnection();
+    Display* display = xcon.display();
     XSetWindowAttributes resizeAttr;
     resizeAttr.event_mask = 0; // we don't want any events such that the decoration window
                                // gets the events with the subwindow set to the respective
                                // resizeArea window
-    resizeAttr.colormap = xcon.usesTransparency() ? xcon.colormap() : dec->colormap;
+    resizeAttr.colormap = xcon.usesTransparency() ? xcon.colormap() : colormap;
     resizeAttr.background_pixel = BlackPixel(display, xcon.screen());
     resizeAttr.border_pixel = BlackPixel(display, xcon.screen());
+    int bw = last_scheme ? last_scheme->border_width() : 0;
     for (size_t i = 0; i < resizeAreaSize; i++) {
+        Rectangle geo = resizeAreaGeometry(i, bw, last_outer_rect.width, last_outer_rect.height);
         Window& win = resizeArea[i];
-        win = XCreateWindow(display, dec->decwin, 0, 0, 30, 30, 0,
+        win = XCreateWindow(display, decwin, geo.x, geo.y,
+                            std::max(1, geo.width), std::max(1, geo.height), 0,
                             0, InputOnly, visual ? visual : xcon.visual(),
                             CWEventMask, &resizeAttr);
         XMapWindow(display, win);
     }
-    // set wm_class for window
-    XClassHint *hint = XAllocClassHint();
-    hint->res_name = (char*)HERBST_DECORATION_CLASS;
-    hint->res_class = (char*)HERBST_DECORATION_CLASS;
-    XSetClassHint(display, dec->decwin, hint);
-    XFree(hint);
+}
+
+void Decoration::destroyResizeAreas()
+{
+    if (!resizeArea[0]) {
+        return;
+    }
+    XConnection& xcon = xconnection();
+    for (size_t i = 0; i < resizeAreaSize; i++) {
+        XDestroyWindow(xcon.display(), resizeArea[i]);
+        resizeArea[i] = 0;
+    }
+}
+
+/**
+ * @brief Apply the setting decoration_resize_windows: either create the
+ * resizeArea windows or let the decoration window itself receive pointer
+ * motion events, in which case the cursor shape is set by updateCursor().
+ */
+void Decoration::updateResizeAreaMode()
+{
+    XConnection& xcon = xconnection();
+    long mask = EnterWindowMask | LeaveWindowMask
+            | ButtonPressMask | ButtonReleaseMask
+            | ExposureMask
+            | SubstructureRedirectMask | FocusChangeMask;
+    if (settings_.decoration_resize_windows()) {
+        if (client_->visible_() && client_->decorated_()) {
+            createResizeAreas();
+        }
+    } else {
+        destroyResizeAreas();
+        mask |= PointerMotionMask;
+    }
+    cursorShape_ = {};
+    XUndefineCursor(xcon.display(), decwin);
+    XSelectInput(xcon.display(), decwin, mask);
+}
+
+/**
+ * @brief Set the cursor shape of the decoration window according to
+ * the resize area at the given pointer position (relative to the
+ * decoration window). This is only used if there are no resizeArea windows.
+ * @param position the pointer position or nothing if the pointer left the decoration
+ */
+void Decoration::updateCursor(std::experimental::optional<Point2D> position)
+{
+    if (resizeArea[0]) {
+        return;
+    }
+    ResizeAction act;
+    if (position.has_value() && client_->decorated_()) {
+        act = resizeAreaAt(position.value()) * client_->possibleResizeActions();
+    }
+    auto shape = act.toCursorShape();
+    if (shape == cursorShape_) {
+        return;
+    }
+    cursorShape_ = shape;
+    XConnection& xcon = xconnection();
+    if (shape.has_value()) {
+        XDefineCursor(xcon.display(), decwin, fontCursor(shape.value()));
+    } else {
+        XUndefineCursor(xcon.display(), decwin);
+    }
+}
+
+/**
+ * @brief Create the X resources whose creation was deferred while
+ * the client was hidden. This is called right before the decoration
+ * window is mapped.
+ */
+void Decoration::prepareMap()
+{
+    if (!client_->decorated_()) {
+        return;
+    }
+    if (settings_.decoration_resize_windows()) {
+        createResizeAreas();
+    }
+    if (redrawPending_) {
+        redrawPending_ = false;
+        XConnection& xcon = xconnection();
+        redrawPixmap();
+        XSetWindowBackgroundPixmap(xcon.display(), decwin, pixmap);
+        XClearWindow(xcon.display(), decwin);
+    }
 }
 
 Decoration::~Decoration() {
@@ -188,19 +295,36 @@ Rectangle Decoration::inner_to_outer(Rectangle rect) {
 void Decoration::updateResizeAreaCursors()
 {
     XConnection& xcon = xconnection();
+    if (!resizeArea[0]) {
+        return;
+    }
     for (size_t i = 0; i < resizeAreaSize; i++) {
         Window& win = resizeArea[i];
         ResizeAction act = resizeAreaInfo(i);
         act = act * client_->possibleResizeActions();
         auto cursor = act.toCursorShape();
         if (cursor.has_value()) {
-            XDefineCursor(xcon.display(), win, XCreateFontCursor(xcon.display(), cursor.value()));
+            XDefineCursor(xcon.display(), win, fontCursor(cursor.value()));
         } else {
             XUndefineCursor(xcon.display(), win);
         }
     }
 }
 
+//! the font cursor of the given shape, created only once per shape
+Cursor Decoration::fontCursor(unsigned int shape)
+{
+    static std::map<unsigned int, Cursor> cursors;
+    auto it = cursors.find(shape);
+    if (it != cursors.end()) {
+        return it->second;
+    }
+    XConnection& xcon = xconnection();
+    Cursor cursor = XCreateFontCursor(xcon.display(), shape);
+    cursors[shape] = cursor;
+    return cursor;
+}
+
 std::experimental::optional<Decoration::ClickArea>
 Decoration::positionHasButton(Point2D p)
 {
@@ -353,6 +477,9 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     // update structs
     bool size_changed = outline.width != last_outer_rect.width
                      || outline.height != last_outer_rect.height;
+    if (outline != last_outer_rect && client_->tag()) {
+        client_->tag()->floatingIndex().invalidate();
+    }
     last_outer_rect = outline;
     last_rect_inner = false;
     tabs_ = tabs;
@@ -368,11 +495,17 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     }
     XConnection& xcon = xconnection();
     if (decorated) {
-        redrawPixmap();
-        XSetWindowBackgroundPixmap(xcon.display(), decwin, pixmap);
-        if (!size_changed) {
-            // if size changes, then the window is cleared automatically
-            XClearWindow(xcon.display(), decwin);
+        if (!client_->visible_()) {
+            // drawing a hidden decoration is deferred until it is shown
+            redrawPending_ = true;
+        } else {
+            redrawPending_ = false;
+            redrawPixmap();
+            XSetWindowBackgroundPixmap(xcon.display(), decwin, pixmap);
+            if (!size_changed) {
+                // if size changes, then the window is cleared automatically
+                XClearWindow(xcon.display(), decwin);
+            }
         }
         if (!client_->dragged_ || settings_.update_dragged_clients()) {
             XConfigureWindow(xcon.display(), win, mask, &changes);
@@ -385,7 +518,7 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
         XConfigureWindow(xcon.display(), win, mask, &changes);
     }
     // update geometry of resizeArea window
-    if (decorated) {
+    if (decorated && resizeArea[0]) {
         int bw = 0;
         if (last_scheme) {
             bw = last_scheme->border_width();
@@ -397,6 +530,8 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
                               areaGeo.x, areaGeo.y,
                               areaGeo.width, areaGeo.height);
         }
+    }
+    if (decorated) {
         XMoveResizeWindow(xcon.display(), decwin,
                           outline.x, outline.y, outline.width, outline.height);
     }
@@ -778,6 +913,23 @@ ResizeAction Decoration::resizeAreaInfo(size_t idx)
     return act;
 }
 
+/**
+ * @brief The resize action of the resize area at the given position
+ * (relative to the decoration window), i.e. what the resizeArea window
+ * at this position would indicate.
+ */
+ResizeAction Decoration::resizeAreaAt(Point2D p)
+{
+    int bw = last_scheme ? last_scheme->border_width() : 0;
+    for (size_t i = 0; i < resizeAreaSize; i++) {
+        Rectangle geo = resizeAreaGeometry(i, bw, last_outer_rect.width, last_outer_rect.height);
+        if (geo.contains(p)) {
+            return resizeAreaInfo(i);
+        }
+    }
+    return {};
+}
+
 Rectangle Decoration::resizeAreaGeometry(size_t idx, int borderWidth, int width, int height)
 {
     if (idx < 6) {
@@ -63,6 +63,9 @@ public:
     Rectangle inner_to_outer(Rectangle rect);
 
     void updateResizeAreaCursors();
+    void updateResizeAreaMode();
+    void updateCursor(std::experimental::optional<Point2D> position);
+    void prepareMap();
 
     std::experimental::optional<ClickArea> positionHasButton(Point2D p);
     ResizeAction positionTriggersResize(Point2D p);
@@ -73,6 +76,9 @@ private:
     static Visual* check_32bit_client(Client* c);
     static XConnection& xconnection();
     void redrawPixmap();
+    void createResizeAreas();
+    void destroyResizeAreas();
+    static Cursor fontCursor(unsigned int shape);
     void updateFrameExtends();
 
     void drawText(Pixmap& pix, GC& gc, const FontData& fontData,
@@ -94,6 +100,7 @@ private:
     Pixmap                  pixmap = 0;
     int                     pixmap_height = 0;
     int                     pixmap_width = 0;
+    bool                    redrawPending_ = false; //! whether the pixmap is outdated
     // fill the area behind client with another window that does nothing,
     // especially not repainting or background filling to avoid flicker on
     // unmap
@@ -103,6 +110,9 @@ private:
     Window                  resizeArea[resizeAreaSize] = {};
     static ResizeAction resizeAreaInfo(size_t idx);
     Rectangle resizeAreaGeometry(size_t idx, int borderWidth, int width, int height);
+    ResizeAction resizeAreaAt(Point2D p);
+    //! the cursor shape defined on decwin if there are no resizeArea windows
+    std::experimental::optional<unsigned int> cursorShape_;
 private:
     Client* client_; // the client to decorate
     Settings& settings_;
@@ -21,6 +21,7 @@
 #include "utils.h"
 #include "xconnection.h"
 
+using std::make_pair;
 using std::pair;
 using std::string;
 using std::to_string;
@@ -71,14 +72,17 @@ const std::array<const char*,NetCOUNT> Ewmh::netatomNames_ =
 Ewmh::Ewmh(XConnection& xconnection)
     : X_(xconnection)
 {
-    /* init ewmh net atoms */
+    /* init ewmh net atoms, the WM atoms, and the hlwm specific atoms
+     * in one go */
+    vector<string> atomNames;
     for (int i = 0; i < NetCOUNT; i++) {
         if (!netatomNames_[i]) {
             HSWarning("no name specified in g_netatom_names "
                       "for atom number %d\n", i);
+            atomNames.push_back("");
             continue;
         }
-        netatom_[i] = XInternAtom(X_.display(), netatomNames_[i], False);
+        atomNames.push_back(netatomNames_[i]);
     }
 
     vector<pair<WM,const char*>> wm2name = {
@@ -90,11 +94,40 @@ Ewmh::Ewmh(XConnection& xconnection)
         { WM::TakeFocus,    "WM_TAKE_FOCUS" },
     };
     for (const auto& init : wm2name) {
-        auto atom = XInternAtom(X_.display(), init.second, False);
-        wmatom_[static_cast<size_t>(init.first)] = atom;
+        atomNames.push_back(init.second);
     }
-    hlwmFloatingWindow_ = X_.atom("HLWM_FLOATING_WINDOW");
-    hlwmTilingWindow_ = X_.atom("HLWM_TILING_WINDOW");
+    atomNames.push_back("HLWM_FLOATING_WINDOW");
+    atomNames.push_back("HLWM_TILING_WINDOW");
+    // the selections, which are looked up in the atom table later
+    atomNames.push_back("WM_S" + to_string(X_.screen()));
+    atomNames.push_back("_NET_WM_CM_S" + to_string(X_.screen()));
+    vector<Atom> atoms = X_.internAtoms(atomNames);
+    for (int i = 0; i < NetCOUNT; i++) {
+        if (netatomNames_[i]) {
+            netatom_[i] = atoms[i];
+        }
+    }
+    for (size_t i = 0; i < wm2name.size(); i++) {
+        wmatom_[static_cast<size_t>(wm2name[i].first)] = atoms[NetCOUNT + i];
+    }
+    hlwmFloatingWindow_ = atoms[NetCOUNT + wm2name.size()];
+    hlwmTilingWindow_ = atoms[NetCOUNT + wm2name.size() + 1];
+
+    // the handlers for the client messages, looked up by the message type
+    vector<pair<int, ClientMessageHandler>> netHandlers = {
+        { NetActiveWindow,      &Ewmh::netActiveWindowMessage },
+        { NetCurrentDesktop,    &Ewmh::netCurrentDesktopMessage },
+        { NetWmDesktop,         &Ewmh::netWmDesktopMessage },
+        { NetWmState,           &Ewmh::netWmStateMessage },
+        { NetWmMoveresize,      &Ewmh::netWmMoveresizeMessage },
+        { NetCloseWindow,       &Ewmh::netCloseWindowMessage },
+    };
+    for (const auto& handler : netHandlers) {
+        clientMessageHandlers_[netatom_[handler.first]] =
+            make_pair(netatomNames_[handler.first], handler.second);
+    }
+    clientMessageHandlers_[wmatom(WM::ChangeState)] =
+        make_pair("WM_CHANGE_STATE", &Ewmh::wmChangeStateMessage);
 
     readInitialEwmhState();
 
@@ -208,14 +241,14 @@ bool Ewmh::acquireScreenSelection(bool replaceExistingWm)
 Atom Ewmh::windowManagerSelection()
 {
     string atomName = "WM_S" + to_string(X_.screen());
-    return XInternAtom(X_.display(), atomName.c_str(), False);
+    return X_.atom(atomName.c_str());
 }
 
 Atom Ewmh::compositingManagerSelection()
 {
     // see https://specifications.freedesktop.org/wm-spec/wm-spec-latest.html#idm45381391209264
     string atomName = "_NET_WM_CM_S" + to_string(X_.screen());
-    return XInternAtom(X_.display(), atomName.c_str(), False);
+    return X_.atom(atomName.c_str());
 }
 
 bool Ewmh::detectCompositingManager()
@@ -274,7 +307,25 @@ void Ewmh::updateWmName() {
 }
 
 void Ewmh::updateClientList() {
+    if (netClientListIndex_.size() != netClientList_.size()) {
+        // drop the entries of the removed windows
+        netClientList_.erase(std::remove(netClientList_.begin(), netClientList_.end(), None),
+                             netClientList_.end());
+        for (size_t i = 0; i < netClientList_.size(); i++) {
+            netClientListIndex_[netClientList_[i]] = i;
+        }
+    }
     X_.setPropertyWindow(X_.root(), netatom_[NetClientList], netClientList_);
+    clientListDirty_ = false;
+}
+
+void Ewmh::flushClientLists() {
+    if (clientListDirty_) {
+        updateClientList();
+    }
+    if (clientListStackingDirty_) {
+        updateClientListStacking();
+    }
 }
 
 const Ewmh::InitialState &Ewmh::initialState()
@@ -301,18 +352,33 @@ void Ewmh::updateClientListStacking() {
     std::reverse(buf.begin(), buf.end());
 
     X_.setPropertyWindow(X_.root(), netatom_[NetClientListStacking], buf);
+    clientListStackingDirty_ = false;
 }
 
 void Ewmh::addClient(Window win) {
+    if (netClientListIndex_.find(win) != netClientListIndex_.end()) {
+        return;
+    }
+    netClientListIndex_[win] = netClientList_.size();
     netClientList_.push_back(win);
-    updateClientList();
-    updateClientListStacking();
+    if (!clientListDirty_) {
+        // the property is up to date, so only send the new window
+        X_.appendPropertyWindow(X_.root(), netatom_[NetClientList], { win });
+    }
+    clientListStackingDirty_ = true;
 }
 
 void Ewmh::removeClient(Window win) {
-    netClientList_.erase(std::remove(netClientList_.begin(), netClientList_.end(), win), netClientList_.end());
-    updateClientList();
-    updateClientListStacking();
+    auto it = netClientListIndex_.find(win);
+    if (it == netClientListIndex_.end()) {
+        return;
+    }
+    // the list is compacted and written only once for all
+    // windows removed in the current event batch
+    netClientList_[it->second] = None;
+    netClientListIndex_.erase(it);
+    clientListDirty_ = true;
+    clientListStackingDirty_ = true;
 }
 
 void Ewmh::updateDesktops() {
@@ -361,156 +427,139 @@ bool Ewmh::focusStealingAllowed(long source) {
 }
 
 void Ewmh::handleClientMessage(XClientMessageEvent* me) {
-    HSDebug("Received event: ClientMessage: \"%s\" for %lx\n",
-            X_.atomName(me->message_type).c_str(),
-            me->window);
-    if (me->message_type == wmatom(WM::ChangeState)) {
-        if (me->data.l[0] == static_cast<long>(WmState::WSIconicState)) {
-            Client* client = Root::common().client(me->window);
-            if (client) {
-                client->minimized_ = true;
-            }
-        }
+    auto it = clientMessageHandlers_.find(me->message_type);
+    if (it == clientMessageHandlers_.end()) {
+        // the atom name is only asked for if it is printed
+        HSDebug("received unknown client message \"%s\" for %lx\n",
+                X_.atomName(me->message_type).c_str(),
+                me->window);
         return;
     }
-    int index;
-    for (index = 0; index < NetCOUNT; index++) {
-        if (me->message_type == netatom_[index]) {
-            break;
+    HSDebug("Received event: ClientMessage: \"%s\" for %lx\n",
+            it->second.first, me->window);
+    (this ->* it->second.second)(me);
+}
+
+void Ewmh::wmChangeStateMessage(XClientMessageEvent* me) {
+    if (me->data.l[0] == static_cast<long>(WmState::WSIconicState)) {
+        Client* client = Root::common().client(me->window);
+        if (client) {
+            client->minimized_ = true;
         }
     }
-    if (index >= NetCOUNT) {
-        HSDebug("received unknown client message\n");
+}
+
+void Ewmh::netActiveWindowMessage(XClientMessageEvent* me) {
+    // only steal focus if allowed to the current source
+    // (i.e. me->data.l[0] in this case as specified by EWMH)
+    auto client = Root::common().client(me->window);
+    if (!client) {
         return;
     }
+    if (focusStealingAllowed(me->data.l[0])) {
+        focus_client(client, true, true, true);
+    } else {
+        // Focus stealing is not allowed, at least mark the client urgent
+        client->urgent_ = true;
+    }
+}
 
-    int desktop_index;
-    switch (index) {
-        case NetActiveWindow: {
-            // only steal focus if allowed to the current source
-            // (i.e. me->data.l[0] in this case as specified by EWMH)
-            if (focusStealingAllowed(me->data.l[0])) {
-                auto client = Root::common().client(me->window);
-                if (client) {
-                    focus_client(client, true, true, true);
-                }
-            } else {
-                // Focus stealing is not allowed, at least mark the client urgent
-                auto client = Root::common().client(me->window);
-                if (client) {
-                    client->urgent_ = true;
-                }
-            }
-            break;
-        }
+void Ewmh::netCurrentDesktopMessage(XClientMessageEvent* me) {
+    int desktop_index = me->data.l[0];
+    if (desktop_index < 0 || desktop_index >= tag_get_count()) {
+        HSDebug("_NET_CURRENT_DESKTOP: invalid index \"%d\"\n",
+                desktop_index);
+        return;
+    }
+    HSTag* tag = get_tag_by_index(desktop_index);
+    monitor_set_tag(get_current_monitor(), tag);
+}
 
-        case NetCurrentDesktop: {
-            desktop_index = me->data.l[0];
-            if (desktop_index < 0 || desktop_index >= tag_get_count()) {
-                HSDebug("_NET_CURRENT_DESKTOP: invalid index \"%d\"\n",
-                        desktop_index);
-                break;
-            }
-            HSTag* tag = get_tag_by_index(desktop_index);
-            monitor_set_tag(get_current_monitor(), tag);
-            break;
-        }
+void Ewmh::netWmDesktopMessage(XClientMessageEvent* me) {
+    int desktop_index = me->data.l[0];
+    if (!focusStealingAllowed(me->data.l[1])) {
+        return;
+    }
+    HSTag* target = get_tag_by_index(desktop_index);
+    auto client = Root::common().client(me->window);
+    if (client && target) {
+        tags_->moveClient(client, target);
+    }
+}
 
-        case NetWmDesktop: {
-            desktop_index = me->data.l[0];
-            if (!focusStealingAllowed(me->data.l[1])) {
-                break;
-            }
-            HSTag* target = get_tag_by_index(desktop_index);
-            auto client = Root::common().client(me->window);
-            if (client && target) {
-                tags_->moveClient(client, target);
-            }
-            break;
-        }
+void Ewmh::netWmStateMessage(XClientMessageEvent* me) {
+    auto client = Root::common().client(me->window);
+    /* ignore requests for unmanaged windows */
+    if (!client || !client->ewmhrequests_) {
+        return;
+    }
 
-        case NetWmState: {
-            auto client = Root::common().client(me->window);
-            /* ignore requests for unmanaged windows */
-            if (!client || !client->ewmhrequests_) {
-                break;
-            }
+    /* mapping between EWMH atoms and client struct members */
+    struct {
+        int     atom_index;
+        bool    enabled;
+        void    (*callback)(Client*, bool);
+    } client_atoms[] = {
+        { NetWmStateFullscreen,
+            client->fullscreen_,     [](Client* c, bool state){ c->fullscreen_ = state; } },
+        { NetWmStateDemandsAttention,
+            client->urgent_,         [](Client* c, bool state){ c->urgent_ = state; } },
+    };
 
-            /* mapping between EWMH atoms and client struct members */
-            struct {
-                int     atom_index;
-                bool    enabled;
-                void    (*callback)(Client*, bool);
-            } client_atoms[] = {
-                { NetWmStateFullscreen,
-                    client->fullscreen_,     [](Client* c, bool state){ c->fullscreen_ = state; } },
-                { NetWmStateDemandsAttention,
-                    client->urgent_,         [](Client* c, bool state){ c->urgent_ = state; } },
-            };
-
-            /* me->data.l[1] and [2] describe the properties to alter */
-            for (int prop = 1; prop <= 2; prop++) {
-                if (me->data.l[prop] == 0) {
-                    /* skip if no property is specified */
-                    continue;
-                }
-                /* check if we support the property data[prop] */
-                size_t i;
-                for (i = 0; i < LENGTH(client_atoms); i++) {
-                    if (netatom_[client_atoms[i].atom_index]
-                        == static_cast<unsigned int>(me->data.l[prop])) {
-                        break;
-                    }
-                }
-                if (i >= LENGTH(client_atoms)) {
-                    /* property will not be handled */
-                    continue;
-                }
-                auto new_value = ArrayInitializer<bool,3>({
-                    { _NET_WM_STATE_REMOVE  , false },
-                    { _NET_WM_STATE_ADD     , true },
-                    { _NET_WM_STATE_TOGGLE  , !client_atoms[i].enabled },
-                }).a;
-                int action = me->data.l[0];
-                if (action >= static_cast<int>(new_value.size())) {
-                    HSDebug("_NET_WM_STATE: invalid action %d\n", action);
-                }
-                /* change the value */
-                client_atoms[i].callback(client, new_value[action]);
-            }
-            break;
+    /* me->data.l[1] and [2] describe the properties to alter */
+    for (int prop = 1; prop <= 2; prop++) {
+        if (me->data.l[prop] == 0) {
+            /* skip if no property is specified */
+            continue;
         }
-
-        case NetWmMoveresize: {
-            auto client = Root::common().client(me->window);
-            if (!client) {
+        /* check if we support the property data[prop] */
+        size_t i;
+        for (i = 0; i < LENGTH(client_atoms); i++) {
+            if (netatom_[client_atoms[i].atom_index]
+                == static_cast<unsigned int>(me->data.l[prop])) {
                 break;
             }
-            int direction = me->data.l[2];
-            if (direction == _NET_WM_MOVERESIZE_MOVE
-                || direction == _NET_WM_MOVERESIZE_MOVE_KEYBOARD) {
-                root_->mouse->mouse_initiate_move(client, {});
-            } else if (direction == _NET_WM_MOVERESIZE_CANCEL) {
-                if (root_->mouse->mouse_is_dragging()) {
-                    root_->mouse->mouse_stop_drag();
-                }
-            } else {
-                // anything else is a resize
-                root_->mouse->mouse_initiate_resize(client, vector<string>());
-            }
-            break;
         }
-
-        case NetCloseWindow: {
-            windowClose(me->window);
-            break;
+        if (i >= LENGTH(client_atoms)) {
+            /* property will not be handled */
+            continue;
+        }
+        auto new_value = ArrayInitializer<bool,3>({
+            { _NET_WM_STATE_REMOVE  , false },
+            { _NET_WM_STATE_ADD     , true },
+            { _NET_WM_STATE_TOGGLE  , !client_atoms[i].enabled },
+        }).a;
+        int action = me->data.l[0];
+        if (action < 0 || action >= static_cast<int>(new_value.size())) {
+            HSDebug("_NET_WM_STATE: invalid action %d\n", action);
+            continue;
         }
+        /* change the value */
+        client_atoms[i].callback(client, new_value[action]);
+    }
+}
 
-        default:
-            HSDebug("no handler for the client message \"%s\"\n",
-                    netatomNames_[index]);
-            break;
+void Ewmh::netWmMoveresizeMessage(XClientMessageEvent* me) {
+    auto client = Root::common().client(me->window);
+    if (!client) {
+        return;
     }
+    int direction = me->data.l[2];
+    if (direction == _NET_WM_MOVERESIZE_MOVE
+        || direction == _NET_WM_MOVERESIZE_MOVE_KEYBOARD) {
+        root_->mouse->mouse_initiate_move(client, {});
+    } else if (direction == _NET_WM_MOVERESIZE_CANCEL) {
+        if (root_->mouse->mouse_is_dragging()) {
+            root_->mouse->mouse_stop_drag();
+        }
+    } else {
+        // anything else is a resize
+        root_->mouse->mouse_initiate_resize(client, vector<string>());
+    }
+}
+
+void Ewmh::netCloseWindowMessage(XClientMessageEvent* me) {
+    windowClose(me->window);
 }
 
 void Ewmh::updateWindowState(Client* client) {
@@ -687,10 +736,17 @@ string Ewmh::getWindowTitle(Window win) {
  */
 int Ewmh::getWindowType(Window win) {
     auto atoms = X_.getWindowPropertyAtom(win, netatom_[NetWmWindowType]);
-    if (!atoms.has_value() || atoms.value().empty()) {
+    if (!atoms.has_value()) {
+        return -1;
+    }
+    return windowTypeFromAtoms(atoms.value());
+}
+
+int Ewmh::windowTypeFromAtoms(const vector<Atom>& windowTypes) {
+    if (windowTypes.empty()) {
         return -1;
     }
-    Atom windowtype = atoms.value()[0];
+    Atom windowtype = windowTypes[0];
     for (int i = NetWmWindowTypeFIRST; i <= NetWmWindowTypeLAST; i++) {
         // try to find the window type
         if (windowtype == netatom_[i]) {
@@ -5,6 +5,7 @@
 #include <X11/Xlib.h>
 #include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /* actions on NetWmState */
@@ -145,6 +146,10 @@ public:
 
     void updateClientList();
     void updateClientListStacking();
+    //! the stacking order changed, _NET_CLIENT_LIST_STACKING is updated in flushClientLists()
+    void invalidateClientListStacking() { clientListStackingDirty_ = true; }
+    //! write the client lists that changed since the last call
+    void flushClientLists();
     void updateDesktops();
     void updateDesktopNames();
     void updateActiveWindow(Window win);
@@ -158,6 +163,8 @@ public:
     std::string getWindowTitle(Window win);
 
     int getWindowType(Window win);
+    //! the window type given by the first entry of a _NET_WM_WINDOW_TYPE
+    int windowTypeFromAtoms(const std::vector<Atom>& windowTypes);
 
     bool isOwnWindow(Window win);
     void clearInputFocus();
@@ -182,6 +189,16 @@ public:
 
 private:
     bool focusStealingAllowed(long source);
+    using ClientMessageHandler = void (Ewmh::*)(XClientMessageEvent*);
+    //! the name of the message type and the handler for each supported client message
+    std::unordered_map<Atom, std::pair<const char*, ClientMessageHandler>> clientMessageHandlers_;
+    void wmChangeStateMessage(XClientMessageEvent* me);
+    void netActiveWindowMessage(XClientMessageEvent* me);
+    void netCurrentDesktopMessage(XClientMessageEvent* me);
+    void netWmDesktopMessage(XClientMessageEvent* me);
+    void netWmStateMessage(XClientMessageEvent* me);
+    void netWmMoveresizeMessage(XClientMessageEvent* me);
+    void netCloseWindowMessage(XClientMessageEvent* me);
     Root* root_ = nullptr;
     TagManager* tags_ = nullptr;
     XConnection& X_;
@@ -192,8 +209,15 @@ private:
     Atom hlwmFloatingWindow_; //! x11 property set on floated clients
     Atom hlwmTilingWindow_; //! x11 property set on tiled clients
 
-    //! array with Window-IDs in initial mapping order for _NET_CLIENT_LIST
+    //! array with Window-IDs in initial mapping order for _NET_CLIENT_LIST.
+    //! Removed windows are None until the list is written the next time.
     std::vector<Window> netClientList_;
+    //! the position of each window in netClientList_
+    std::unordered_map<Window, size_t> netClientListIndex_;
+    //! whether the _NET_CLIENT_LIST property is outdated. Initially, it
+    //! may still contain the list of a previous window manager
+    bool clientListDirty_ = true;
+    bool clientListStackingDirty_ = true;
     //! window that shows that the WM is still alive
     Window      windowManagerWindow_;
 
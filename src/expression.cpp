@@ -0,0 +1,321 @@
+#include "expression.h"
+
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+#include "attribute.h"
+#include "object.h"
+
+using std::string;
+using std::stringstream;
+using std::to_string;
+
+//! the operators, longer operators first such that they take precedence
+static const char* const g_operators[] = {
+    "==", "!=", "<=", ">=", "&&", "||",
+    "<", ">", "!", "+", "-", "(", ")",
+};
+
+//! parse an integer, accepting nothing else than an optional minus and digits
+static bool parseInteger(const string& str, long long& value) {
+    size_t start = (!str.empty() && str[0] == '-') ? 1 : 0;
+    if (start >= str.size() || str.size() - start > 18) {
+        return false;
+    }
+    for (size_t i = start; i < str.size(); i++) {
+        if (!isdigit(static_cast<unsigned char>(str[i]))) {
+            return false;
+        }
+    }
+    value = std::stoll(str);
+    return true;
+}
+
+static bool isPathCharacter(char c) {
+    return isalnum(static_cast<unsigned char>(c))
+        || c == '_' || c == '-' || c == OBJECT_PATH_SEPARATOR;
+}
+
+static string boolString(bool value) {
+    return value ? "true" : "false";
+}
+
+Expression::Expression(Object& root, AttributeLookup attributeLookup)
+    : root_(root)
+    , attributeLookup_(attributeLookup)
+{
+}
+
+bool Expression::isTrue(const string& value)
+{
+    return !value.empty() && value != "false" && value != "0";
+}
+
+string Expression::evaluate(const string& source)
+{
+    tokenize(source);
+    pos_ = 0;
+    nestingDepth_ = 0;
+    string value = parseOr(true);
+    if (tokens_[pos_].type_ != TokenType::End) {
+        fail("unexpected", tokens_[pos_]);
+    }
+    return value;
+}
+
+void Expression::tokenize(const string& source)
+{
+    tokens_.clear();
+    size_t i = 0;
+    while (i < source.size()) {
+        char c = source[i];
+        if (isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+        Token token = { TokenType::Operator, "", i };
+        if (isdigit(static_cast<unsigned char>(c))) {
+            token.type_ = TokenType::Number;
+            while (i < source.size() && isdigit(static_cast<unsigned char>(source[i]))) {
+                token.text_ += source[i++];
+            }
+        } else if (c == '"' || c == '\'') {
+            token.type_ = TokenType::String;
+            i++;
+            while (i < source.size() && source[i] != c) {
+                token.text_ += source[i++];
+            }
+            if (i >= source.size()) {
+                fail("unterminated string", token);
+            }
+            i++; // the closing quote
+        } else if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            token.type_ = TokenType::AttributePath;
+            while (i < source.size() && isPathCharacter(source[i])) {
+                token.text_ += source[i++];
+            }
+        } else {
+            for (const char* op : g_operators) {
+                if (source.compare(i, string(op).size(), op) == 0) {
+                    token.text_ = op;
+                    break;
+                }
+            }
+            if (token.text_.empty()) {
+                token.text_ = string(1, c);
+                fail("invalid character", token);
+            }
+            i += token.text_.size();
+        }
+        tokens_.push_back(token);
+    }
+    tokens_.push_back({ TokenType::End, "", source.size() });
+}
+
+void Expression::fail(const string& message, const Token& token)
+{
+    stringstream msg;
+    msg << message << " ";
+    if (token.type_ == TokenType::End) {
+        msg << "end of expression";
+    } else {
+        msg << "\"" << token.text_ << "\" at position " << token.position_;
+    }
+    throw std::invalid_argument(msg.str());
+}
+
+//! called before each recursion that is not bounded by the precedence levels
+void Expression::enterNesting(const Token& token)
+{
+    nestingDepth_++;
+    if (nestingDepth_ > maxNestingDepth_) {
+        fail("expression nested too deeply", token);
+    }
+}
+
+bool Expression::accept(const string& op)
+{
+    const Token& token = tokens_[pos_];
+    if (token.type_ == TokenType::Operator && token.text_ == op) {
+        pos_++;
+        return true;
+    }
+    return false;
+}
+
+void Expression::expect(const string& op)
+{
+    if (!accept(op)) {
+        fail("expected \"" + op + "\" but got", tokens_[pos_]);
+    }
+}
+
+string Expression::parseOr(bool eval)
+{
+    string value = parseAnd(eval);
+    while (accept("||")) {
+        bool result = isTrue(value);
+        bool right = isTrue(parseAnd(eval && !result));
+        value = boolString(result || right);
+    }
+    return value;
+}
+
+string Expression::parseAnd(bool eval)
+{
+    string value = parseNot(eval);
+    while (accept("&&")) {
+        bool result = isTrue(value);
+        bool right = isTrue(parseNot(eval && result));
+        value = boolString(result && right);
+    }
+    return value;
+}
+
+string Expression::parseNot(bool eval)
+{
+    const Token& token = tokens_[pos_];
+    if (accept("!")) {
+        enterNesting(token);
+        string value = boolString(!isTrue(parseNot(eval)));
+        nestingDepth_--;
+        return value;
+    }
+    return parseComparison(eval);
+}
+
+string Expression::parseComparison(bool eval)
+{
+    string left = parseSum(eval);
+    for (const char* op : { "==", "!=", "<=", ">=", "<", ">" }) {
+        if (!accept(op)) {
+            continue;
+        }
+        string right = parseSum(eval);
+        int cmp;
+        long long leftInt, rightInt;
+        if (parseInteger(left, leftInt) && parseInteger(right, rightInt)) {
+            cmp = (leftInt < rightInt) ? -1 : ((leftInt > rightInt) ? 1 : 0);
+        } else {
+            cmp = left.compare(right);
+        }
+        string opString = op;
+        if (opString == "==") {
+            return boolString(cmp == 0);
+        } else if (opString == "!=") {
+            return boolString(cmp != 0);
+        } else if (opString == "<=") {
+            return boolString(cmp <= 0);
+        } else if (opString == ">=") {
+            return boolString(cmp >= 0);
+        } else if (opString == "<") {
+            return boolString(cmp < 0);
+        } else {
+            return boolString(cmp > 0);
+        }
+    }
+    return left;
+}
+
+string Expression::parseSum(bool eval)
+{
+    string value = parsePrimary(eval);
+    while (true) {
+        const Token& opToken = tokens_[pos_];
+        bool plus = accept("+");
+        if (!plus && !accept("-")) {
+            return value;
+        }
+        string right = parsePrimary(eval);
+        if (!eval) {
+            continue;
+        }
+        long long leftInt, rightInt;
+        bool numeric = parseInteger(value, leftInt) && parseInteger(right, rightInt);
+        if (plus) {
+            value = numeric ? to_string(leftInt + rightInt) : value + right;
+        } else if (numeric) {
+            value = to_string(leftInt - rightInt);
+        } else {
+            fail("non-numeric operands for", opToken);
+        }
+    }
+}
+
+string Expression::parsePrimary(bool eval)
+{
+    const Token& token = tokens_[pos_];
+    switch (token.type_) {
+        case TokenType::Number:
+        case TokenType::String:
+            pos_++;
+            return token.text_;
+        case TokenType::AttributePath: {
+            pos_++;
+            if (token.text_ == "true" || token.text_ == "false") {
+                return token.text_;
+            }
+            if (token.text_ == "exists") {
+                expect("(");
+                const Token& path = tokens_[pos_];
+                if (path.type_ != TokenType::AttributePath) {
+                    fail("expected an object path but got", path);
+                }
+                pos_++;
+                expect(")");
+                return eval ? exists(path.text_) : "";
+            }
+            if (!eval) {
+                return "";
+            }
+            Attribute* a = attributeLookup_(token.text_);
+            if (!a) {
+                fail("no such attribute", token);
+            }
+            return a->str();
+        }
+        case TokenType::Operator:
+            if (accept("(")) {
+                enterNesting(token);
+                string value = parseOr(eval);
+                expect(")");
+                nestingDepth_--;
+                return value;
+            }
+            if (accept("-")) {
+                enterNesting(token);
+                string value = parsePrimary(eval);
+                nestingDepth_--;
+                long long number;
+                if (!eval) {
+                    return value;
+                }
+                if (!parseInteger(value, number)) {
+                    fail("non-numeric operand for", token);
+                }
+                return to_string(-number);
+            }
+            break;
+        case TokenType::End:
+            break;
+    }
+    fail("unexpected", token);
+    return "";
+}
+
+//! whether there is an attribute or an object with the given path
+string Expression::exists(const string& path)
+{
+    if (attributeLookup_(path)) {
+        return boolString(true);
+    }
+    string objectPath = path;
+    while (!objectPath.empty() && objectPath.back() == OBJECT_PATH_SEPARATOR) {
+        objectPath.pop_back();
+    }
+    Path objectPathArgs = objectPath.empty()
+            ? Path(ArgList::Container())
+            : Path(objectPath, OBJECT_PATH_SEPARATOR);
+    return boolString(root_.child(objectPathArgs) != nullptr);
+}
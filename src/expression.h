@@ -0,0 +1,68 @@
+#ifndef __HERBST_EXPRESSION_H_
+#define __HERBST_EXPRESSION_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class Attribute;
+class Object;
+
+/**
+ * @brief A small expression language that is evaluated against the
+ * object tree, see the documentation of the 'expr' command.
+ *
+ * All values are strings. Values that look like integers are compared
+ * and added numerically, all others are compared lexicographically and
+ * concatenated. Evaluation errors are reported by throwing
+ * std::invalid_argument.
+ */
+class Expression {
+public:
+    using AttributeLookup = std::function<Attribute*(const std::string&)>;
+    Expression(Object& root, AttributeLookup attributeLookup);
+    std::string evaluate(const std::string& source);
+    //! whether the value counts as true in boolean operations
+    static bool isTrue(const std::string& value);
+private:
+    enum class TokenType {
+        Number,
+        String,
+        AttributePath,
+        Operator,
+        End,
+    };
+    class Token {
+    public:
+        TokenType type_;
+        std::string text_;
+        size_t position_;
+    };
+    void tokenize(const std::string& source);
+    // the recursive descent parser, one method per precedence level.
+    // if 'eval' is false, the expression is only parsed and attributes
+    // are not looked up (used for short-circuit evaluation)
+    std::string parseOr(bool eval);
+    std::string parseAnd(bool eval);
+    std::string parseNot(bool eval);
+    std::string parseComparison(bool eval);
+    std::string parseSum(bool eval);
+    std::string parsePrimary(bool eval);
+    std::string exists(const std::string& path);
+    bool accept(const std::string& op);
+    void expect(const std::string& op);
+    void fail(const std::string& message, const Token& token);
+    void enterNesting(const Token& token);
+
+    //! the maximum nesting depth of parentheses and unary operators,
+    //! such that deep nesting does not overflow the stack
+    static const size_t maxNestingDepth_ = 256;
+
+    Object& root_;
+    AttributeLookup attributeLookup_;
+    std::vector<Token> tokens_;
+    size_t pos_ = 0;
+    size_t nestingDepth_ = 0;
+};
+
+#endif
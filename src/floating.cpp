@@ -8,6 +8,7 @@
 
 #include "client.h"
 #include "decoration.h"
+#include "floatingindex.h"
 #include "layout.h"
 #include "monitor.h"
 #include "settings.h"
@@ -157,90 +158,18 @@ int Floating::find_rectangle_right_of(RectangleIdxVec rects, int idx) {
     return idxbest;
 }
 
-// returns the found index in the modified buffer
-int Floating::find_edge_in_direction(RectangleIdxVec& rects, int idx, Direction dir)
-{
-    rectlist_rotate(rects, idx, dir);
-    int found = find_edge_right_of(rects, idx);
-    if (found < 0) {
-        return found;
-    }
-    // rotate back, by requesting the inverse rotation
-    //switch (dir) {
-    //    case DirLeft: break; // DirLeft is inverse to itself
-    //    case DirRight: break; // DirRight is the identity
-    //    case DirUp: dir = DirDown; break; // once was rotated 90 deg counterclockwise..
-    //                                      // now has to be rotate 90 deg clockwise back
-    //    case DirDown: dir = DirUp; break;
-    //}
-    rectlist_rotate(rects, found, dir);
-    rectlist_rotate(rects, found, dir);
-    rectlist_rotate(rects, found, dir);
-    return found;
-}
-
-int Floating::find_edge_right_of(RectangleIdxVec rects, int idx) {
-    int xbound = rects[idx].second.x + rects[idx].second.width;
-    int ylow = rects[idx].second.y;
-    int yhigh = rects[idx].second.y + rects[idx].second.height;
-    // only keep rectangles with a x coordinate right of the xbound
-    // and with an appropriate y/height
-    //
-    //      +---------+ - - - - - - - - - - -
-    //      |   idx   |   area of intrest
-    //      +---------+ - - - - - - - - - - -
-    int leftmost = -1;
-    int dist = INT_MAX;
-    int i = -1;
-    for (const auto& r : rects) {
-        i++; // count indices manually
-        if (i == idx) {
-            continue;
-        }
-        if (r.second.x <= xbound) {
-            continue;
-        }
-        int low = r.second.y;
-        int high = low + r.second.height;
-        if (!intervals_intersect(ylow, yhigh, low, high)) {
-            continue;
-        }
-        if (r.second.x - xbound < dist) {
-            dist = r.second.x - xbound;
-            leftmost = i;
-        }
-    }
-    return leftmost;
-}
-
-
 bool Floating::focusDirection(Direction dir) {
     if (g_settings->monitors_locked()) { return false; }
     HSTag* tag = get_current_monitor()->tag;
-    vector<Client*> clients;
-    RectangleIdxVec rects;
-    int idx = 0;
-    int curfocusidx = -1;
     Client* curfocus = get_current_client();
-    tag->foreachClient([&](Client* c) {
-        if (!c->visible_()) {
-            return;
-        }
-        clients.push_back(c);
-        rects.push_back(make_pair(idx,c->dec->last_outer()));
-        if (c == curfocus) {
-            curfocusidx = idx;
-        }
-        idx++;
-    });
-    if (curfocusidx < 0 || idx <= 0) {
+    if (!curfocus) {
         return false;
     }
-    idx = find_rectangle_in_direction(rects, curfocusidx, dir);
-    if (idx < 0) {
+    Client* found = tag->floatingIndex().clientInDirection(curfocus, dir);
+    if (!found) {
         return false;
     }
-    focus_client(clients[idx], false, false, true);
+    focus_client(found, false, false, true);
     return true;
 }
 
@@ -248,61 +177,32 @@ bool Floating::focusDirection(Direction dir) {
 //! report the vector to travel until the collision happens. If curfocusrect
 //! is provided, use this as the geometry of 'curfocus'
 Point2D Floating::find_rectangle_collision_on_tag(HSTag* tag, Client* curfocus, Direction dir, Rectangle curfocusrect) {
-    vector<Client*> clients;
+    FloatingIndex& index = tag->floatingIndex();
+    if (!index.contains(curfocus)) {
+        return {0, 0};
+    }
     auto focusrect = curfocusrect
                 ? curfocusrect
                 : curfocus->dec->last_outer();
-    RectangleIdxVec rects;
-    int idx = 0;
-    int curfocusidx = -1;
-    tag->foreachClient([&](Client* c) {
-        if (!c->visible_()) {
-            return;
-        }
-        clients.push_back(c);
-        if (c == curfocus) {
-            rects.push_back(make_pair(idx,focusrect));
-            curfocusidx = idx;
-        } else {
-            rects.push_back(make_pair(idx,c->dec->last_outer()));
-        }
-        idx++;
-    });
-    if (curfocusidx < 0 || idx <= 0) {
-        return {0, 0};
-    }
     // add artifical rects for screen edges
-    {
-        auto mr = get_current_monitor()->getFloatingArea();
-        vector<Rectangle> tmp = {
-            { mr.x, mr.y,               mr.width, 0 }, // top
-            { mr.x, mr.y,               0, mr.height }, // left
-            { mr.x + mr.width, mr.y,    0, mr.height }, // right
-            { mr.x, mr.y + mr.height,   mr.y + mr.width, 0 }, // bottom
-        };
-        for (const auto& r : tmp) {
-            rects.push_back(make_pair(-1, r));
-        }
-    }
-    for (auto& r : rects) {
-        // don't apply snapgap to focused client, so there will be exactly
-        // snap_gap pixels between the focused client and the found edge
-        if (r.first == curfocusidx) {
-            continue;
-        }
-        // expand anything by the snap gap
-        r.second.x -= g_settings->snap_gap();
-        r.second.y -= g_settings->snap_gap();
-        r.second.width += 2 * g_settings->snap_gap();
-        r.second.height += 2 * g_settings->snap_gap();
-    }
-    idx = find_edge_in_direction(rects, curfocusidx, dir);
-    if (idx < 0) {
+    auto mr = get_current_monitor()->getFloatingArea();
+    RectangleVec screenEdges = {
+        { mr.x, mr.y,               mr.width, 0 }, // top
+        { mr.x, mr.y,               0, mr.height }, // left
+        { mr.x + mr.width, mr.y,    0, mr.height }, // right
+        { mr.x, mr.y + mr.height,   mr.y + mr.width, 0 }, // bottom
+    };
+    // expand anything by the snap gap, but not the focused client, so there
+    // will be exactly snap_gap pixels between the focused client and the
+    // found edge
+    auto edge = index.edgeInDirection(curfocus, focusrect, dir,
+                                      g_settings->snap_gap(), screenEdges);
+    if (!edge) {
         return {0, 0};
     }
     // shift client
     int dx = 0, dy = 0;
-    auto r = rects[idx].second;
+    auto r = edge->second;
     //printf("edge: %dx%d at %d,%d\n", r.width, r.height, r.x, r.y);
     //printf("focus: %dx%d at %d,%d\n", focusrect.width, focusrect.height, focusrect.x, focusrect.y);
     switch (dir) {
@@ -16,8 +16,6 @@ public:
     // utilities
     static int find_rectangle_in_direction(RectangleIdxVec& rects, int idx, Direction dir);
     static int find_rectangle_right_of(RectangleIdxVec rects, int idx);
-    static int find_edge_in_direction(RectangleIdxVec& rects, int idx, Direction dir);
-    static int find_edge_right_of(RectangleIdxVec rects, int idx);
 
     // actual implementations
     static bool focusDirection(Direction dir);
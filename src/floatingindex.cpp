@@ -0,0 +1,211 @@
+#include "floatingindex.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include "client.h"
+#include "decoration.h"
+#include "tag.h"
+#include "utils.h"
+
+using std::make_pair;
+using std::pair;
+using std::vector;
+using std::experimental::optional;
+
+static const Direction g_directions[] = {
+    Direction::Right, Direction::Left, Direction::Up, Direction::Down,
+};
+
+static size_t directionIndex(Direction dir) {
+    return static_cast<size_t>(dir);
+}
+
+static int centerX(const Rectangle& r) {
+    return r.x + r.width / 2;
+}
+
+static int centerY(const Rectangle& r) {
+    return r.y + r.height / 2;
+}
+
+FloatingIndex::FloatingIndex(HSTag* tag)
+    : tag_(tag)
+{
+}
+
+/**
+ * @brief Rotate the given rectangle such that the direction 'dir'
+ * becomes the direction 'right'. This is the per-rectangle version
+ * of rectlist_rotate() in floating.cpp.
+ */
+Rectangle FloatingIndex::rotate(Rectangle r, Direction dir)
+{
+    switch (dir) {
+        case Direction::Right: return r;
+        case Direction::Left: return { -r.x - r.width, r.y, r.width, r.height };
+        case Direction::Down: return { r.y, r.x, r.height, r.width };
+        case Direction::Up: return { -r.y - r.height, r.x, r.height, r.width };
+    }
+    return r;
+}
+
+void FloatingIndex::update()
+{
+    if (valid_) {
+        return;
+    }
+    clients_.clear();
+    outlines_.clear();
+    clientToSlot_.clear();
+    tag_->foreachClient([this](Client* c) {
+        if (!c->visible_()) {
+            return;
+        }
+        clientToSlot_[c] = clients_.size();
+        clients_.push_back(c);
+        outlines_.push_back(c->dec->last_outer());
+    });
+    size_t count = clients_.size();
+    for (Direction dir : g_directions) {
+        size_t d = directionIndex(dir);
+        // rectlist_rotate() reverses the list for these directions
+        // and so the search order for rectangles with the same center
+        bool reversed = dir == Direction::Up || dir == Direction::Left;
+        vector<Rectangle>& rects = rotated_[d];
+        vector<size_t>& order = order_[d];
+        rects.resize(count);
+        order.resize(count);
+        byCenter_[d].resize(count);
+        byLeftEdge_[d].resize(count);
+        for (size_t slot = 0; slot < count; slot++) {
+            rects[slot] = rotate(outlines_[slot], dir);
+            order[slot] = reversed ? count - 1 - slot : slot;
+            byCenter_[d][slot] = slot;
+            byLeftEdge_[d][slot] = slot;
+        }
+        std::sort(byCenter_[d].begin(), byCenter_[d].end(),
+                  [&](size_t a, size_t b) {
+            return make_pair(centerX(rects[a]), order[a])
+                   < make_pair(centerX(rects[b]), order[b]);
+        });
+        std::sort(byLeftEdge_[d].begin(), byLeftEdge_[d].end(),
+                  [&](size_t a, size_t b) {
+            return make_pair(rects[a].x, order[a])
+                   < make_pair(rects[b].x, order[b]);
+        });
+    }
+    valid_ = true;
+}
+
+bool FloatingIndex::contains(Client* client)
+{
+    update();
+    return clientToSlot_.find(client) != clientToSlot_.end();
+}
+
+Client* FloatingIndex::clientInDirection(Client* from, Direction dir)
+{
+    update();
+    auto source = clientToSlot_.find(from);
+    if (source == clientToSlot_.end()) {
+        return nullptr;
+    }
+    size_t d = directionIndex(dir);
+    const vector<Rectangle>& rects = rotated_[d];
+    const vector<size_t>& order = order_[d];
+    size_t sourceSlot = source->second;
+    int cx = centerX(rects[sourceSlot]);
+    int cy = centerY(rects[sourceSlot]);
+    // only rectangles whose center is right of the source's center
+    // are candidates, see rectangle_is_right_of() in floating.cpp
+    const vector<size_t>& sorted = byCenter_[d];
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), cx,
+                               [&](size_t slot, int value) {
+        return centerX(rects[slot]) < value;
+    });
+    size_t best = clients_.size();
+    int distbest = INT_MAX;
+    for (; it != sorted.end(); it++) {
+        size_t slot = *it;
+        if (slot == sourceSlot) {
+            continue;
+        }
+        int dx = centerX(rects[slot]) - cx;
+        if (dx > distbest) {
+            // the manhattan distance of all remaining
+            // rectangles is at least dx
+            break;
+        }
+        int dy = centerY(rects[slot]) - cy;
+        if (abs(dy) > dx) {
+            continue;
+        }
+        if (dx == 0 && dy == 0 && order[slot] < order[sourceSlot]) {
+            // if two rectangles have the same center, then
+            // only go forward in the search order
+            continue;
+        }
+        int dist = dx + abs(dy);
+        if (dist < distbest
+            || (dist == distbest && order[slot] < order[best]))
+        {
+            distbest = dist;
+            best = slot;
+        }
+    }
+    if (best >= clients_.size()) {
+        return nullptr;
+    }
+    return clients_[best];
+}
+
+optional<pair<int, Rectangle>>
+    FloatingIndex::edgeInDirection(Client* exclude, Rectangle rect,
+                                   Direction dir, int gap,
+                                   const RectangleVec& obstacles)
+{
+    update();
+    size_t d = directionIndex(dir);
+    const vector<Rectangle>& rects = rotated_[d];
+    Rectangle focus = rotate(rect, dir);
+    int xbound = focus.x + focus.width;
+    int ylow = focus.y;
+    int yhigh = focus.y + focus.height;
+    optional<pair<int, Rectangle>> result;
+    // the enlarged rectangle must be entirely right of xbound
+    const vector<size_t>& sorted = byLeftEdge_[d];
+    auto it = std::upper_bound(sorted.begin(), sorted.end(), xbound + gap,
+                               [&](int value, size_t slot) {
+        return value < rects[slot].x;
+    });
+    for (; it != sorted.end(); it++) {
+        size_t slot = *it;
+        if (clients_[slot] == exclude) {
+            continue;
+        }
+        const Rectangle& r = rects[slot];
+        if (!intervals_intersect(ylow, yhigh, r.y - gap, r.y + r.height + gap)) {
+            continue;
+        }
+        // the first match has the smallest distance
+        result = make_pair(r.x - gap - xbound, outlines_[slot].adjusted(gap, gap));
+        break;
+    }
+    for (const auto& obstacle : obstacles) {
+        Rectangle enlarged = obstacle.adjusted(gap, gap);
+        Rectangle r = rotate(enlarged, dir);
+        if (r.x <= xbound) {
+            continue;
+        }
+        if (!intervals_intersect(ylow, yhigh, r.y, r.y + r.height)) {
+            continue;
+        }
+        int dist = r.x - xbound;
+        if (!result || dist < result->first) {
+            result = make_pair(dist, enlarged);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,65 @@
+#ifndef __HERBST_FLOATINGINDEX_H_
+#define __HERBST_FLOATINGINDEX_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "converter.h"
+#include "optional.h"
+#include "rectangle.h"
+
+class Client;
+class HSTag;
+
+/**
+ * @brief A spatial index over the outer geometries of the visible clients
+ * on a tag, used for the directional focus and the collision detection
+ * of floating windows.
+ *
+ * For each of the four directions, the rectangles are rotated such that
+ * the direction becomes 'right' (the same way the utilities in Floating do
+ * it) and are kept in lists sorted by their center and by their left edge.
+ * Hence, a query only needs to look at the rectangles close to the queried
+ * rectangle. The index is rebuilt lazily after invalidate() was called,
+ * i.e. whenever the geometry, visibility, or order of the tag's clients
+ * may have changed.
+ */
+class FloatingIndex {
+public:
+    FloatingIndex(HSTag* tag);
+    void invalidate() { valid_ = false; }
+
+    //! the client that Floating::find_rectangle_in_direction() would find
+    //! relative to 'from' on the tag
+    Client* clientInDirection(Client* from, Direction dir);
+
+    //! the first outer geometry (enlarged by 'gap' on each side) of a
+    //! client other than 'exclude' or of one of the 'obstacles' that is
+    //! hit when moving 'rect' into the direction 'dir'. The first entry
+    //! is the distance to travel.
+    std::experimental::optional<std::pair<int, Rectangle>>
+        edgeInDirection(Client* exclude, Rectangle rect, Direction dir, int gap,
+                        const RectangleVec& obstacles = {});
+
+    bool contains(Client* client);
+
+    //! rotate the rectangle such that 'dir' becomes Direction::Right
+    static Rectangle rotate(Rectangle rect, Direction dir);
+private:
+    void update();
+    HSTag* tag_;
+    bool valid_ = false;
+    std::vector<Client*> clients_;
+    std::vector<Rectangle> outlines_;
+    std::unordered_map<Client*, size_t> clientToSlot_;
+    //! the geometries of clients_, one vector per direction
+    std::vector<Rectangle> rotated_[4];
+    //! the position of the client in the search order of the direction
+    std::vector<size_t> order_[4];
+    //! the slots sorted by the center x coordinate of rotated_
+    std::vector<size_t> byCenter_[4];
+    //! the slots sorted by the left edge of rotated_
+    std::vector<size_t> byLeftEdge_[4];
+};
+
+#endif
@@ -715,6 +715,7 @@ int FrameTree::loadCommand(Input input, Output output) {
         m->applyLayout();
         monitor_update_focus_objects();
     } else {
+        tag->layoutCache().invalidate();
         tag->frame->root_->setVisibleRecursive(false);
     }
     return 0;
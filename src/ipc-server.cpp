@@ -3,6 +3,7 @@
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <algorithm>
 #include <cstdio>
 
 #include "ipc-protocol.h"
@@ -11,10 +12,30 @@
 using std::string;
 using std::vector;
 
+//! the name of the property for the hook with the given number
+static string hookPropertyName(int hookNumber) {
+    char atomName[1000];
+    snprintf(atomName, 1000, HERBST_HOOK_PROPERTY_FORMAT, hookNumber);
+    return atomName;
+}
+
 IpcServer::IpcServer(XConnection& xconnection)
     : X(xconnection)
     , nextHookNumber_(0)
 {
+    // intern all atoms of the ipc protocol at once
+    vector<string> atomNames = {
+        HERBST_HOOK_WIN_ID_ATOM,
+        HERBST_IPC_ARGS_ATOM,
+        HERBST_IPC_OUTPUT_ATOM,
+        HERBST_IPC_ERROR_ATOM,
+        HERBST_IPC_STATUS_ATOM,
+        HERBST_IPC_HAS_ERROR,
+    };
+    for (int i = 0; i < HERBST_HOOK_PROPERTY_COUNT; i++) {
+        atomNames.push_back(hookPropertyName(i));
+    }
+    X.internAtoms(atomNames);
     // main task of the construtor is to setup the hook window
     hookEventWindow_ = XCreateSimpleWindow(X.display(), X.root(),
                                              42, 42, 42, 42, 0, 0, 0);
@@ -42,19 +63,81 @@ void IpcServer::addConnection(Window window) {
     XSelectInput(X.display(), window, PropertyChangeMask);
 }
 
-bool IpcServer::handleConnection(Window win, CallHandler callback) {
+bool IpcServer::queueConnection(Window win, CallHandler callback) {
     std::experimental::optional<vector<string>> maybeArguments =
             X.getWindowPropertyTextList(win, X.atom(HERBST_IPC_ARGS_ATOM));
     if (!maybeArguments.has_value()) {
         // if the args atom is not present any more then it already has been
-        // executed (e.g. after being called by ipc_add_connection())
+        // read (e.g. after being called by ipc_add_connection())
+        return false;
+    }
+    // Mark this command as read, such that further property
+    // notifications do not queue it a second time
+    XDeleteProperty(X.display(), win, X.atom(HERBST_IPC_ARGS_ATOM));
+    if (pendingCalls_.size() >= maxPendingCalls) {
+        runPendingCall(callback);
+    }
+    pendingCalls_.push_back({ win, std::move(maybeArguments.value()) });
+    return true;
+}
+
+bool IpcServer::runPendingCall(CallHandler callback) {
+    if (pendingCalls_.empty()) {
+        return false;
+    }
+    PendingCall call = std::move(pendingCalls_.front());
+    pendingCalls_.pop_front();
+    CallId id = nextCallId_++;
+    CallResult& result = emptyResult();
+    callback(id, std::move(call.arguments), result);
+    if (result.pending) {
+        // keep the client window, such that the reply can be sent later
+        deferredCalls_[id] = call.window;
+    } else {
+        reply(call.window, result);
+    }
+    return true;
+}
+
+IpcServer::CallResult& IpcServer::emptyResult() {
+    result_.exitCode = 0;
+    result_.output.clear();
+    result_.error.clear();
+    result_.pending = false;
+    return result_;
+}
+
+bool IpcServer::completeCall(CallId id, const CallResult& result) {
+    auto it = deferredCalls_.find(id);
+    if (it == deferredCalls_.end()) {
+        // the client window was destroyed meanwhile
         return false;
     }
-    auto result = callback(maybeArguments.value());
+    Window window = it->second;
+    deferredCalls_.erase(it);
+    reply(window, result);
+    return true;
+}
+
+void IpcServer::removeConnection(Window window) {
+    pendingCalls_.erase(
+        std::remove_if(pendingCalls_.begin(), pendingCalls_.end(),
+                       [window](const PendingCall& call) {
+                            return call.window == window;
+                       }),
+        pendingCalls_.end());
+    for (auto it = deferredCalls_.begin(); it != deferredCalls_.end(); ) {
+        if (it->second == window) {
+            it = deferredCalls_.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void IpcServer::reply(Window win, const CallResult& result) {
     // send output back
     int status = result.exitCode;
-    // Mark this command as executed
-    XDeleteProperty(X.display(), win, X.atom(HERBST_IPC_ARGS_ATOM));
     X.setPropertyString(win, X.atom(HERBST_IPC_OUTPUT_ATOM), result.output);
     X.setPropertyString(win, X.atom(HERBST_IPC_ERROR_ATOM), result.error);
     // and also set the exit status
@@ -85,7 +168,6 @@ bool IpcServer::handleConnection(Window win, CallHandler callback) {
     };
     while (XCheckIfEvent(X.display(), &dummy, predicate, (XPointer)&context)) {
     }
-    return true;
 }
 
 bool IpcServer::isConnectable(Window window) {
@@ -97,9 +179,8 @@ void IpcServer::emitHook(vector<string> args) {
         // nothing to do
         return;
     }
-    static char atom_name[1000];
-    snprintf(atom_name, 1000, HERBST_HOOK_PROPERTY_FORMAT, nextHookNumber_);
-    X.setPropertyString(hookEventWindow_, X.atom(atom_name), args);
+    string atomName = hookPropertyName(nextHookNumber_);
+    X.setPropertyString(hookEventWindow_, X.atom(atomName.c_str()), args);
     // set counter for next property
     nextHookNumber_ += 1;
     nextHookNumber_ %= HERBST_HOOK_PROPERTY_COUNT;
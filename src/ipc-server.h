@@ -2,7 +2,9 @@
 #define __HERBSTLUFT_IPC_SERVER_H_
 
 #include <X11/X.h>
+#include <deque>
 #include <functional>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +18,18 @@ public:
         int exitCode = 0;
         std::string output;
         std::string error;
+        //! if set, then the call is not answered yet, but only when
+        //completeCall() is called for it later
+        bool pending = false;
     };
+    //! identifies a call whose reply was deferred
+    using CallId = unsigned long;
     //! a callback that handles a call, represented by a vector of strings. The
-    // callback can produce some output and return a status code.
-    // This is the counterpart of hc_send_command() in ipc-client/ipc-client.h
-    using CallHandler = std::function<CallResult(const std::vector<std::string>&)>;
+    // callback writes its output and status code to the given (empty) result,
+    // or marks the result as pending and completes the call with the given id
+    // later. This is the counterpart of hc_send_command() in
+    // ipc-client/ipc-client.h
+    using CallHandler = std::function<void(CallId, std::vector<std::string>, CallResult&)>;
     IpcServer(XConnection& xconnection);
     ~IpcServer();
 
@@ -29,14 +38,49 @@ public:
     //! listen for ipc requests on the given window, but don't read them
     //if there are requests already.
     void addConnection(Window win);
-    //! try to run an ipc request in the given window via the given callback,
-    //return if there was one
-    bool handleConnection(Window window, CallHandler callback);
+    //! read the ipc request in the given window and add it to the queue of
+    //pending calls, return if there was one. If the queue is full, the
+    //oldest pending call is run via the given callback first.
+    bool queueConnection(Window window, CallHandler callback);
+    //! run the oldest pending call via the given callback and send the
+    //reply to its client, return if there was one
+    bool runPendingCall(CallHandler callback);
+    bool hasPendingCalls() const { return !pendingCalls_.empty(); }
+    //! send the reply to a call whose handler returned a pending result,
+    //return whether its client is still waiting for it
+    bool completeCall(CallId id, const CallResult& result);
+    //! the result buffer that is reused for all replies, emptied
+    CallResult& emptyResult();
+    //! whether the client of a deferred call still waits for the reply
+    bool hasDeferredCall(CallId id) const {
+        return deferredCalls_.find(id) != deferredCalls_.end();
+    }
+    //! forget the pending and deferred calls of a destroyed client window
+    void removeConnection(Window window);
     //! send a hook to all listening clients
     void emitHook(std::vector<std::string> args);
 
+    //! the maximum number of calls that are read but not yet answered
+    static const size_t maxPendingCalls = 64;
+
 private:
+    class PendingCall {
+    public:
+        Window window;
+        std::vector<std::string> arguments;
+    };
+    void reply(Window window, const CallResult& result);
+
     XConnection& X;
+    //! the calls that are read from their client windows but that are not
+    //executed yet, in the order in which they arrived
+    std::deque<PendingCall> pendingCalls_;
+    //! the client windows of the calls that are run but not answered yet
+    std::map<CallId, Window> deferredCalls_;
+    CallId nextCallId_ = 1;
+    //! the calls are run one after another, so they all share one buffer
+    //for their output, such that the output strings keep their capacity
+    CallResult result_;
 
     Window hookEventWindow_; //! window on which the hooks are announced
     int nextHookNumber_; //! index for the next hook
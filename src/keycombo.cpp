@@ -7,6 +7,7 @@
 
 #include "completion.h"
 #include "globals.h"
+#include "root.h"
 #include "utils.h"
 #include "xkeygrabber.h"
 
@@ -232,11 +233,14 @@ template<> void Converter<KeyCombo>::complete(Completion& complete, KeyCombo con
     const string releasePrefix = string(KeyCombo::releaseModifier) + ModifierCombo::defaultSeparator();
     complete.partial(releasePrefix);
     ModifiersWithString::complete(complete, [&releasePrefix] (Completion& compWrapped, string prefix) {
-        // Offer full completions for a final keysym:
-        auto keySyms = XKeyGrabber::getPossibleKeySyms();
-        for (const auto& keySym : keySyms) {
-            compWrapped.full(prefix + keySym);
-            compWrapped.full(releasePrefix + prefix + keySym);
+        // Offer full completions for a final keysym, looking only at
+        // the keysyms matching the needle:
+        const auto& keySyms = Root::get()->xKeyGrabber_->getPossibleKeySyms();
+        for (const string& keyPrefix : { prefix, releasePrefix + prefix }) {
+            auto range = compWrapped.matchingKeys(keySyms, keyPrefix);
+            for (auto it = range.first; it != range.second; it++) {
+                compWrapped.full(keyPrefix + *it);
+            }
         }
     });
 }
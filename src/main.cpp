@@ -4,7 +4,7 @@
 #include <locale.h>
 #include <sys/wait.h>
 #include <unistd.h>
-#include <csignal>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -35,6 +35,7 @@
 #include "rulemanager.h"
 #include "settings.h"
 #include "tagmanager.h"
+#include "timermanager.h"
 #include "tmp.h"
 #include "utils.h"
 #include "watchers.h"
@@ -77,6 +78,7 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
     RuleManager* rules = root->rules();
     Settings* settings = root->settings();
     TagManager* tags = root->tags();
+    TimerManager* timers = root->timers();
     Tmp* tmp = root->tmp();
     Watchers* watchers = root->watchers();
 
@@ -182,7 +184,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
         {"layout",         tags->frameCommand(&FrameTree::dumpLayoutCommand, &FrameTree::dumpLayoutCompletion)},
         {"stack",          { monitors, &MonitorManager::stackCommand }},
         {"dump",           tags->frameCommand(&FrameTree::dumpLayoutCommand, &FrameTree::dumpLayoutCompletion)},
-        {"load",           { tags->frameCommand(&FrameTree::loadCommand, &FrameTree::loadCompletion ) }},
+        {"load",           tags->frameCommand(&FrameTree::loadCommand, &FrameTree::loadCompletion)
+                                .deferReply() },
         {"complete",       completeCommand},
         {"complete_shell", completeCommand},
         {"lock",           { [monitors] { monitors->lock(); return 0; } }},
@@ -190,8 +193,9 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
         {"lock_tag",       monitors->byFirstArg(&Monitor::lock_tag_cmd, &Monitor::noComplete) },
         {"unlock_tag",     monitors->byFirstArg(&Monitor::unlock_tag_cmd, &Monitor::noComplete) },
         {"set_layout",     { tags->frameCommand(&FrameTree::setLayoutCommand, &FrameTree::setLayoutCompletion) }},
-        {"detect_monitors",{ monitors, &MonitorManager::detectMonitorsCommand,
-                                       &MonitorManager::detectMonitorsCompletion }},
+        {"detect_monitors",CommandBinding(monitors, &MonitorManager::detectMonitorsCommand,
+                                          &MonitorManager::detectMonitorsCompletion)
+                                .deferReply() },
         {"!",              { meta_commands, &MetaCommands::negateCommand,
                                             &MetaCommands::completeCommandShifted1 }},
         {"chain",          { meta_commands, &MetaCommands::chainCommand,
@@ -202,6 +206,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                             &MetaCommands::chainCompletion}},
         {"object_tree",    { meta_commands, &MetaCommands::print_object_tree_command,
                                             &MetaCommands::print_object_tree_complete} },
+        {"dump_objects",   { meta_commands, &MetaCommands::dumpObjectsCommand,
+                                            &MetaCommands::print_object_tree_complete} },
         {"substitute",     { meta_commands, &MetaCommands::substitute_cmd,
                                             &MetaCommands::substitute_complete} },
         {"foreach",        { meta_commands, &MetaCommands::foreachCommand} },
@@ -213,6 +219,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                             &MetaCommands::remove_attr_complete }},
         {"compare",        { meta_commands, &MetaCommands::compare_cmd,
                                             &MetaCommands::compare_complete} },
+        {"expr",           { meta_commands, &MetaCommands::exprCommand,
+                                            &MetaCommands::exprCompletion} },
         {"getenv",         { meta_commands, &MetaCommands::getenvCommand,
                                             &MetaCommands::getenvUnsetenvCompletion}},
         {"setenv",         { meta_commands, &MetaCommands::setenvCommand,
@@ -223,6 +231,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                             &MetaCommands::getenvUnsetenvCompletion}},
         {"get_attr",       { meta_commands, &MetaCommands::get_attr_cmd,
                                             &MetaCommands::get_attr_complete }},
+        {"get_attrs",      { meta_commands, &MetaCommands::get_attrs_cmd,
+                                            &MetaCommands::get_attrs_complete }},
         {"set_attr",       { meta_commands, &MetaCommands::set_attr_cmd,
                                             &MetaCommands::set_attr_complete }},
         {"attr_type",      { meta_commands, &MetaCommands::attrTypeCommand,
@@ -233,6 +243,9 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                             &MetaCommands::attr_complete }},
         {"watch",          { watchers, &Watchers::watchCommand,
                                        &Watchers::watchCompletion }},
+        {"timer",          { timers, &TimerManager::timerCommand }},
+        {"untimer",        { timers, &TimerManager::untimerCommand,
+                                     &TimerManager::untimerCompletion }},
         {"mktemp",         { tmp, &Tmp::mktemp,
                                   &Tmp::mktempComplete }},
     };
@@ -356,21 +369,6 @@ static void parse_arguments(int argc, char** argv, Globals& g) {
     g.trueTransparency = !noTransparency;
 }
 
-static void handle_signal(int signal) {
-    HSDebug("Interrupted by signal %d\n", signal);
-    if (g_main_loop) {
-        g_main_loop->quit();
-    }
-    return;
-}
-
-static void sigaction_signal(int signum, void (*handler)(int)) {
-    struct sigaction act = {};
-    act.sa_handler = handler;
-    sigemptyset(&act.sa_mask);
-    act.sa_flags = SA_NOCLDSTOP | SA_RESTART;
-    sigaction(signum, &act, nullptr);
-}
 /* ---- */
 /* main */
 /* ---- */
@@ -380,6 +378,15 @@ int main(int argc, char* argv[]) {
     parse_arguments(argc, argv, g);
     g.globalAutostartPath = HERBSTLUFT_GLOBAL_AUTOSTART;
 
+    // with --verbose, report how long the phases of the startup take
+    auto phaseStart = std::chrono::steady_clock::now();
+    auto startupPhaseDone = [&phaseStart](const char* phase) {
+        auto now = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - phaseStart);
+        HSDebug("startup: %s took %lld ms\n", phase, (long long)ms.count());
+        phaseStart = now;
+    };
+
     if (!setlocale(LC_CTYPE, "") || !XSupportsLocale()) {
         std::cerr << "warning: no locale support" << endl;
     }
@@ -400,12 +407,7 @@ int main(int argc, char* argv[]) {
     if (g.trueTransparency) {
         X->tryInitTransparency();
     }
-    // ignore sigchld, but set it anyway such that we don't
-    // receive anything on stopped children (SA_NOCLDSTOP)
-    sigaction_signal(SIGCHLD, [](int) {});
-    sigaction_signal(SIGINT,  handle_signal);
-    sigaction_signal(SIGQUIT, handle_signal);
-    sigaction_signal(SIGTERM, handle_signal);
+    XMainLoop::installSignalHandlers();
     // set some globals
     g_root = X->root();
     XSelectInput(X->display(), X->root(), SubstructureRedirectMask|SubstructureNotifyMask|ButtonPressMask|EnterWindowMask|LeaveWindowMask|StructureNotifyMask);
@@ -431,7 +433,9 @@ int main(int argc, char* argv[]) {
         }
     }
     root->monitors()->ensure_monitors_are_available();
+    startupPhaseDone("connecting and initializing");
     mainloop.scanExistingClients();
+    startupPhaseDone("scanning the existing windows");
     tag_force_update_flags();
     all_monitors_apply_layout();
     ewmh->updateAll();
@@ -439,6 +443,7 @@ int main(int argc, char* argv[]) {
         // if no client is focused, focus dummy window:
         ewmh->clearInputFocus();
     }
+    startupPhaseDone("applying the layouts");
     mainloop.childExited.connect(root->autostart(), &Autostart::childExited);
     root->autostart()->reloadCmd();
 
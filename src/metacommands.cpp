@@ -15,6 +15,7 @@
 #include "attribute_.h"
 #include "command.h"
 #include "completion.h"
+#include "expression.h"
 #include "finite.h"
 #include "ipc-protocol.h"
 #include "regexstr.h"
@@ -103,6 +104,57 @@ int MetaCommands::get_attr_cmd(Input in, Output output) {
     return 0;
 }
 
+//! print the attribute in the format of the get_attrs command
+static void printAttributeLine(Output output, const string& path, Attribute* a) {
+    output << path << "\t";
+    for (char c : a->str()) {
+        switch (c) {
+            case '\\': output << "\\\\"; break;
+            case '\t': output << "\\t"; break;
+            case '\n': output << "\\n"; break;
+            default: output << c; break;
+        }
+    }
+    output << "\n";
+}
+
+int MetaCommands::get_attrs_cmd(Input in, Output output) {
+    string path;
+    if (!(in >> path)) {
+        return HERBST_NEED_MORE_ARGS;
+    }
+    // first collect all attributes, such that nothing is
+    // printed to the output if a path is invalid
+    vector<pair<string, Attribute*>> attributes;
+    do {
+        if (path.empty() || *path.rbegin() == OBJECT_PATH_SEPARATOR) {
+            // all attributes of an object
+            Object* object = root.child(Object::splitPath(path).first);
+            if (!object) {
+                output.perror() << "No such object " << path << endl;
+                return HERBST_INVALID_ARGUMENT;
+            }
+            for (const auto& it : object->attributes()) {
+                attributes.push_back(make_pair(path + it.first, it.second));
+            }
+        } else {
+            Attribute* a = getAttribute(path, output);
+            if (!a) {
+                return HERBST_INVALID_ARGUMENT;
+            }
+            attributes.push_back(make_pair(path, a));
+        }
+    } while (in >> path);
+    for (const auto& it : attributes) {
+        printAttributeLine(output, it.first, it.second);
+    }
+    return 0;
+}
+
+void MetaCommands::get_attrs_complete(Completion& complete) {
+    completeAttributePath(complete);
+}
+
 int MetaCommands::set_attr_cmd(Input in, Output output) {
     string path, new_value;
     if (!(in >> path >> new_value)) {
@@ -165,7 +217,28 @@ int MetaCommands::attr_cmd(Input in, Output output) {
     }
 }
 
+/**
+ * @brief Look up an attribute via its compiled path, such that
+ * repeated accesses to the same path are cheap.
+ * @return the attribute or nullptr if the path does not exist
+ */
+Attribute* MetaCommands::cachedAttribute(const string& path) {
+    auto it = attributePaths_.find(path);
+    if (it == attributePaths_.end()) {
+        if (attributePaths_.size() >= 1000) {
+            // avoid unbounded growth if many different paths are used
+            attributePaths_.clear();
+        }
+        it = attributePaths_.emplace(path, AttributePath(path)).first;
+    }
+    return it->second.resolve(root);
+}
+
 Attribute* MetaCommands::getAttribute(string path, Output output) {
+    Attribute* cached = cachedAttribute(path);
+    if (cached) {
+        return cached;
+    }
     auto attr_path = Object::splitPath(path);
     auto child = root.child(attr_path.first);
     if (!child) {
@@ -211,6 +284,21 @@ void MetaCommands::print_object_tree_complete(Completion& complete) {
     }
 }
 
+int MetaCommands::dumpObjectsCommand(Input in, Output output) {
+    auto path = Path(in.empty() ? string("") : in.front()).toVector();
+    while (!path.empty() && path.back().empty()) {
+        path.pop_back();
+    }
+    auto child = root.child(path);
+    if (!child) {
+        output.perror() << "No such object " << Path(path).join('.') << endl;
+        return HERBST_INVALID_ARGUMENT;
+    }
+    child->printJson(output.output());
+    output << endl;
+    return 0;
+}
+
 int MetaCommands::attrTypeCommand(Input input, Output output)
 {
     string attrName;
@@ -410,22 +498,42 @@ MetaCommands::FormatString MetaCommands::parseFormatString(const string &format)
     return blobs;
 }
 
+/**
+ * @brief Parse the format string or take it from the cache of
+ * recently used format strings.
+ * @note the reference is valid until the next call
+ */
+const MetaCommands::FormatString& MetaCommands::cachedFormatString(const string& format)
+{
+    auto it = formatStrings_.find(format);
+    if (it != formatStrings_.end()) {
+        return it->second;
+    }
+    // parse before modifying the cache, because parsing may throw
+    FormatString parsed = parseFormatString(format);
+    if (formatStrings_.size() >= 1000) {
+        // avoid unbounded growth if many different format strings are used
+        formatStrings_.clear();
+    }
+    return formatStrings_.emplace(format, std::move(parsed)).first->second;
+}
+
 int MetaCommands::sprintf_cmd(Input input, Output output)
 {
     string ident, formatStringSrc;
     if (!(input >> ident >> formatStringSrc)) {
         return HERBST_NEED_MORE_ARGS;
     }
-    FormatString format;
+    const FormatString* format;
     try {
-        format = parseFormatString(formatStringSrc);
+        format = &cachedFormatString(formatStringSrc);
     }  catch (const std::invalid_argument& e) {
         output.perror() << e.what() << endl;
         return HERBST_INVALID_ARGUMENT;
     }
     // evaluate placeholders in the format string
     string replacedString = "";
-    for (const auto& blob : format) {
+    for (const auto& blob : *format) {
         if (blob.literal_) {
             replacedString += blob.data_;
         } else if (blob.data_ == "c") {
@@ -682,7 +790,10 @@ int MetaCommands::compare_cmd(Input input, Output output)
     if (ap.parsingFails(input, output)) {
         return ap.exitCode();
     }
-    Attribute* a = root.deepAttribute(path, output);
+    Attribute* a = cachedAttribute(path);
+    if (!a) {
+        a = root.deepAttribute(path, output);
+    }
     if (!a) {
         return HERBST_INVALID_ARGUMENT;
     }
@@ -736,6 +847,33 @@ void MetaCommands::compare_complete(Completion &complete) {
     }
 }
 
+int MetaCommands::exprCommand(Input input, Output output)
+{
+    if (input.empty()) {
+        return HERBST_NEED_MORE_ARGS;
+    }
+    // all arguments form the expression, so quoting the entire
+    // expression is optional
+    string source = input.join(' ');
+    Expression expression(root, [this](const string& path) {
+        return cachedAttribute(path);
+    });
+    string value;
+    try {
+        value = expression.evaluate(source);
+    } catch (const std::invalid_argument& e) {
+        output.perror() << e.what() << endl;
+        return HERBST_INVALID_ARGUMENT;
+    }
+    output << value << endl;
+    return Expression::isTrue(value) ? 0 : 1;
+}
+
+void MetaCommands::exprCompletion(Completion& complete)
+{
+    completeAttributePath(complete);
+}
+
 
 void MetaCommands::completeObjectPath(Completion& complete, Object* rootObject,
                                       bool attributes,
@@ -750,17 +888,23 @@ void MetaCommands::completeObjectPath(Completion& complete, Object* rootObject,
     if (!object) {
         return;
     }
+    // only look at the attributes and children matching the needle
     if (attributes) {
-        for (auto& it : object->attributes()) {
-            if (attributeFilter && !attributeFilter(it.second)) {
+        auto range = complete.matchingKeys(object->attributes(), objectPath);
+        for (auto it = range.first; it != range.second; it++) {
+            if (attributeFilter && !attributeFilter(it->second)) {
                 continue;
             }
-            complete.full(objectPath + it.first);
+            complete.full(objectPath + it->first);
         }
     }
-    for (auto& it : object->children()) {
-        complete.partial(objectPath + it.first + OBJECT_PATH_SEPARATOR);
+    string childPrefix;
+    if (!complete.keyNeedle(objectPath, childPrefix)) {
+        return;
     }
+    object->foreachChild([&](const string& name, Object*) {
+        complete.partial(objectPath + name + OBJECT_PATH_SEPARATOR);
+    }, childPrefix);
 }
 
 void MetaCommands::completeObjectPath(Completion& complete, bool attributes,
@@ -1036,7 +1180,6 @@ void MetaCommands::completeEnvName(Completion& complete) {
 
 int MetaCommands::chainCommand(Input input, Output output)
 {
-    vector<vector<string>> commands = splitCommandList(input.toVector());
     int returnCode = 0;
     // the condition that has to be fulfilled if we want to continue
     // execuding commands. the default (for 'chain') is to always continue
@@ -1050,16 +1193,27 @@ int MetaCommands::chainCommand(Input input, Output output)
         // continue executing commands while they are failing
         conditionContinue = [](int code) { return code >= 1; };
     }
-    for (auto& cmd : commands) {
-        if (cmd.empty()) {
+    if (input.empty()) {
+        return returnCode;
+    }
+    const string& separator = input.front();
+    // the commands are views on the arguments of 'input',
+    // so the arguments are not copied
+    auto cmdBegin = input.begin() + 1;
+    while (true) {
+        auto cmdEnd = std::find(cmdBegin, input.end(), separator);
+        if (cmdBegin != cmdEnd) {
             // if command range is empty, do nothing
-            continue;
+            Input cmdinput(*cmdBegin, input, cmdBegin + 1, cmdEnd);
+            returnCode = Commands::call(cmdinput, output);
+            if (!conditionContinue(returnCode)) {
+                break;
+            }
         }
-        Input cmdinput = Input(cmd[0], cmd.begin() + 1, cmd.end());
-        returnCode = Commands::call(cmdinput, output);
-        if (!conditionContinue(returnCode)) {
+        if (cmdEnd == input.end()) {
             break;
         }
+        cmdBegin = cmdEnd + 1;
     }
     return returnCode;
 }
@@ -1085,24 +1239,3 @@ void MetaCommands::chainCompletion(Completion& complete)
         complete.parametersStillExpected();
     }
 }
-
-
-vector<vector<string>> MetaCommands::splitCommandList(ArgList::Container input) {
-    vector<vector<string>> res;
-    if (input.empty()) {
-        return res;
-    }
-    vector<string> current;
-    string separator = input[0];
-    for (size_t i = 1; i < input.size(); i++) {
-        if (input[i] == separator) {
-            res.push_back(current);
-            current = {};
-        } else {
-            current.push_back(input[i]);
-        }
-    }
-    res.push_back(current);
-    return res;
-}
-
@@ -3,9 +3,11 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "attribute.h"
+#include "attributepath.h"
 #include "commandio.h"
 #include "converter.h"
 
@@ -37,12 +39,15 @@ public:
     // is returned
     int get_attr_cmd(Input in, Output output);
     void get_attr_complete(Completion& complete);
+    int get_attrs_cmd(Input in, Output output);
+    void get_attrs_complete(Completion& complete);
     int set_attr_cmd(Input in, Output output);
     void set_attr_complete(Completion& complete);
     int attr_cmd(Input in, Output output);
     void attr_complete(Completion& complete);
     int print_object_tree_command(Input in, Output output);
     void print_object_tree_complete(Completion& complete);
+    int dumpObjectsCommand(Input in, Output output);
     int attrTypeCommand(Input input, Output output);
     void attrTypeCompletion(Completion& complete);
 
@@ -63,6 +68,8 @@ public:
     void remove_attr_complete(Completion& complete);
     int compare_cmd(Input input, Output output);
     void compare_complete(Completion& complete);
+    int exprCommand(Input input, Output output);
+    void exprCompletion(Completion& complete);
     static Attribute* newAttributeWithType(std::string typestr, std::string attr_name, Output output);
     static void completeAttributeType(Completion& complete);
     static void completeObjectPath(Completion& complete, Object* rootObject,
@@ -94,10 +101,12 @@ public:
     int chainCommand(Input input, Output output);
     void chainCompletion(Completion& complete);
 
-    std::vector<std::vector<std::string>> splitCommandList(ArgList::Container input);
 private:
+    Attribute* cachedAttribute(const std::string& path);
     Object& root;
     std::vector<std::unique_ptr<Attribute>> userAttributes_;
+    //! the compiled paths of recently accessed attributes
+    std::unordered_map<std::string, AttributePath> attributePaths_;
 
     class FormatStringBlob {
     public:
@@ -106,6 +115,9 @@ private:
     };
     typedef std::vector<FormatStringBlob> FormatString;
     FormatString parseFormatString(const std::string& format);
+    const FormatString& cachedFormatString(const std::string& format);
+    //! the parsed format strings of recent sprintf calls
+    std::unordered_map<std::string, FormatString> formatStrings_;
 };
 
 
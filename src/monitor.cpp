@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <map>
 #include <sstream>
 #include <vector>
 
@@ -23,9 +24,12 @@
 #include "stack.h"
 #include "tag.h"
 #include "tagmanager.h"
+#include "tilingresult.h"
 #include "utils.h"
+#include "xconnection.h"
 
 using std::endl;
+using std::map;
 using std::string;
 using std::stringstream;
 using std::vector;
@@ -158,6 +162,7 @@ bool Monitor::setTag(HSTag* new_tag) {
 void Monitor::applyLayout() {
     if (settings->monitors_locked) {
         dirty = true;
+        tag->layoutCache().invalidate();
         return;
     }
     dirty = false;
@@ -241,9 +246,26 @@ void Monitor::applyLayout() {
     }
     restack();
     // 2. Update window geometries
+    // If the tag is about to be shown again, its windows still have the
+    // geometries from when it was visible the last time. So only touch
+    // those clients whose geometry or decoration changed since then.
+    LayoutCache& cache = tag->layoutCache();
+    bool warm = !tag->visible() && cache.reusable(cur_rect, isFocused);
+    map<Client*, AppliedStep> applied;
     for (auto& p : res.data) {
         Client* c = p.first;
         bool clientFocused = isFocused && res.focus == c;
+        AppliedStep& step = applied[c];
+        step.geometry = p.second.geometry;
+        step.floatGeometry = c->float_size_;
+        step.floated = p.second.floated;
+        step.fullscreen = c->fullscreen_();
+        step.focused = clientFocused;
+        step.minimalDecoration = p.second.minimalDecoration;
+        step.tabs = p.second.tabs;
+        if (warm && cache.unchanged(c, step)) {
+            continue;
+        }
         if (c->fullscreen_()) {
             c->resize_fullscreen(rect, clientFocused);
         } else if (p.second.floated) {
@@ -254,12 +276,22 @@ void Monitor::applyLayout() {
         }
     }
     for (auto& c : tag->floating_clients_) {
+        bool clientFocused = res.focus == c && isFocused;
+        AppliedStep& step = applied[c];
+        step.floatGeometry = c->float_size_;
+        step.floated = true;
+        step.fullscreen = c->fullscreen_();
+        step.focused = clientFocused;
+        if (warm && cache.unchanged(c, step)) {
+            continue;
+        }
         if (c->fullscreen_()) {
-            c->resize_fullscreen(rect, res.focus == c && isFocused);
+            c->resize_fullscreen(rect, clientFocused);
         } else {
-            c->resize_floating(this, res.focus == c && isFocused);
+            c->resize_floating(this, clientFocused);
         }
     }
+    cache.store(cur_rect, isFocused, applied);
     if (tag->floating) {
         for (auto& p : res.frames) {
             p.first->hide();
@@ -384,9 +416,7 @@ Monitor* get_current_monitor() {
 }
 
 void all_monitors_apply_layout() {
-    for (auto m : *g_monitors) {
-        m->applyLayout();
-    }
+    g_monitors->relayoutAll();
 }
 
 int monitor_set_tag(Monitor* monitor, HSTag* tag) {
@@ -437,6 +467,11 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
     HSTag* old_tag = monitor->tag;
     // save old tag
     monitor->tag_previous = old_tag;
+    // grab the server once for the entire tag switch (the clients' own
+    // grabs in set_visible() are nested into it), such that all clients
+    // of the new tag appear at once and not one by one.
+    XConnection& X = XConnection::get();
+    X.grabServer();
     // 1. show new tag
     monitor->tag = tag;
     // first reset focus and arrange windows
@@ -451,6 +486,7 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
     }
     // 2. hide old tag
     old_tag->setVisible(false);
+    X.ungrabServer();
     // focus window just has been shown
     // discard enternotify-events
     g_monitors->dropEnterNotifyEvents.emit();
@@ -22,6 +22,7 @@
 #include "stack.h"
 #include "tag.h"
 #include "tagmanager.h"
+#include "tilingresult.h"
 #include "utils.h"
 #include "xconnection.h"
 
@@ -312,6 +313,9 @@ Monitor* MonitorManager::byFrame(shared_ptr<Frame> frame)
 
 void MonitorManager::relayoutTag(HSTag* tag)
 {
+    // if the tag is not visible, then its windows do not
+    // match the cached layout anymore
+    tag->layoutCache().invalidate();
     Monitor* m = byTag(tag);
     if (m) {
         m->applyLayout();
@@ -320,6 +324,11 @@ void MonitorManager::relayoutTag(HSTag* tag)
 
 void MonitorManager::relayoutAll()
 {
+    if (tags_) {
+        for (HSTag* tag : *tags_) {
+            tag->layoutCache().invalidate();
+        }
+    }
     for (Monitor* m : *this) {
         m->applyLayout();
     }
@@ -518,7 +527,7 @@ void MonitorManager::restack() {
         buf.push_back(dw.window());
     });
     XRestackWindows(g_display, buf.data(), buf.size());
-    Ewmh::get().updateClientListStacking();
+    Ewmh::get().invalidateClientListStacking();
 }
 
 class StringTree : public TreeInterface {
@@ -588,13 +597,16 @@ int MonitorManager::setMonitors(const RectangleVec& templates) {
         return HERBST_INVALID_ARGUMENT;
     }
     HSTag* tag = nullptr;
+    // only the monitors whose geometry changed need a new layout
+    vector<Monitor*> changed;
     unsigned i;
     for (i = 0; i < std::min(templates.size(), size()); i++) {
         auto m = byIdx(i);
-        if (!m) {
+        if (!m || m->rect() == templates[i]) {
             continue;
         }
         m->rect = templates[i];
+        changed.push_back(m);
     }
     // add additional monitors
     for (; i < templates.size(); i++) {
@@ -602,7 +614,7 @@ int MonitorManager::setMonitors(const RectangleVec& templates) {
         if (!tag) {
             return HERBST_TAG_IN_USE;
         }
-        addMonitor(templates[i], tag);
+        changed.push_back(addMonitor(templates[i], tag));
         tag->setVisible(true);
     }
     // remove monitors if there are too much
@@ -610,8 +622,11 @@ int MonitorManager::setMonitors(const RectangleVec& templates) {
         removeMonitor(byIdx(i));
     }
     monitor_update_focus_objects();
+    // if this changes the pads of a monitor, then it is re-layouted anyway
     autoUpdatePads();
-    all_monitors_apply_layout();
+    for (Monitor* m : changed) {
+        m->applyLayout();
+    }
     return 0;
 }
 
@@ -26,6 +26,13 @@ ChildEntry::ChildEntry(Object& owner, const string& name)
     owner_.addChildDoc(name_, this);
 }
 
+unsigned long Object::treeGeneration_ = 0;
+
+Object::~Object()
+{
+    treeGeneration_++;
+}
+
 pair<ArgList,string> Object::splitPath(const string &path) {
     vector<string> splitpath = ArgList(path, OBJECT_PATH_SEPARATOR).toVector();
     if (splitpath.empty()) {
@@ -42,11 +49,13 @@ void Object::wireAttributes(vector<Attribute*> attrs)
         attr->setOwner(this);
         attribs_[attr->name()] = attr;
     }
+    treeGeneration_++;
 }
 
 void Object::addAttribute(Attribute* attr) {
     attr->setOwner(this);
     attribs_[attr->name()] = attr;
+    treeGeneration_++;
 }
 
 void Object::removeAttribute(Attribute* attr) {
@@ -58,6 +67,7 @@ void Object::removeAttribute(Attribute* attr) {
         return;
     }
     attribs_.erase(it);
+    treeGeneration_++;
 }
 
 void Object::ls(Output out)
@@ -111,8 +121,14 @@ Attribute* Object::attribute(const string &name) {
 
 
 Object* Object::child(const string &name) {
+    bool dynamic = false;
+    return child(name, dynamic);
+}
+
+Object* Object::child(const string &name, bool& dynamic) {
     auto it_dyn = childrenDynamic_.find(name);
     if (it_dyn != childrenDynamic_.end()) {
+        dynamic = true;
         return it_dyn->second();
     }
     auto it = children_.find(name);
@@ -170,11 +186,13 @@ void Object::notifyHooks(HookEvent event, const string& arg)
 void Object::addDynamicChild(function<Object* ()> child, const string& name)
 {
     childrenDynamic_[name] = child;
+    treeGeneration_++;
 }
 
 void Object::addChild(Object* child, const string &name)
 {
     children_[name] = child;
+    treeGeneration_++;
     notifyHooks(HookEvent::CHILD_ADDED, name);
 }
 
@@ -182,6 +200,7 @@ void Object::removeChild(const string &child)
 {
     notifyHooks(HookEvent::CHILD_REMOVED, child);
     children_.erase(child);
+    treeGeneration_++;
 }
 
 void Object::addChildDoc(const string& name, HasDocumentation* doc)
@@ -232,12 +251,52 @@ std::map<string, Object*> Object::children() {
     return allChildren;
 }
 
+void Object::foreachChild(function<void(const string&, Object*)> visitor,
+                          const string& prefix)
+{
+    // merge the sorted static and dynamic children. As in children(),
+    // a dynamic child hides a static child with the same name
+    auto itStatic = children_.lower_bound(prefix);
+    auto itDynamic = childrenDynamic_.lower_bound(prefix);
+    // the names with the given prefix form a contiguous range
+    auto endStatic = itStatic;
+    while (endStatic != children_.end()
+           && endStatic->first.compare(0, prefix.size(), prefix) == 0) {
+        endStatic++;
+    }
+    auto endDynamic = itDynamic;
+    while (endDynamic != childrenDynamic_.end()
+           && endDynamic->first.compare(0, prefix.size(), prefix) == 0) {
+        endDynamic++;
+    }
+    while (itStatic != endStatic || itDynamic != endDynamic) {
+        if (itDynamic == endDynamic
+            || (itStatic != endStatic && itStatic->first < itDynamic->first))
+        {
+            visitor(itStatic->first, itStatic->second);
+            itStatic++;
+            continue;
+        }
+        Object* obj = itDynamic->second();
+        if (itStatic != endStatic && itStatic->first == itDynamic->first) {
+            if (!obj) {
+                obj = itStatic->second;
+            }
+            itStatic++;
+        }
+        if (obj) {
+            visitor(itDynamic->first, obj);
+        }
+        itDynamic++;
+    }
+}
+
 class DirectoryTreeInterface : public TreeInterface {
 public:
     DirectoryTreeInterface(string label, Object* d) : lbl(label), dir(d) {
-        for (auto child : dir->children()) {
-            buf.push_back(child);
-        }
+        dir->foreachChild([this](const string& name, Object* child) {
+            buf.push_back(make_pair(name, child));
+        });
     };
     size_t childCount() override {
         return buf.size();
@@ -261,6 +320,64 @@ void Object::printTree(Output output, string rootLabel) {
     tree_print_to(intface, output);
 }
 
+static void printJsonString(std::ostream& output, const string& str) {
+    output << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"': output << "\\\""; break;
+            case '\\': output << "\\\\"; break;
+            case '\n': output << "\\n"; break;
+            case '\t': output << "\\t"; break;
+            case '\r': output << "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    const char* hex = "0123456789abcdef";
+                    output << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                } else {
+                    output << c;
+                }
+                break;
+        }
+    }
+    output << '"';
+}
+
+/**
+ * @brief Write the attributes and children of this object
+ * recursively as a JSON object. The output is streamed, i.e. no
+ * intermediate copies of the attribute or children maps are made.
+ */
+void Object::printJson(std::ostream& output) {
+    output << "{\"attributes\":{";
+    bool first = true;
+    for (const auto& it : attribs_) {
+        Attribute* a = it.second;
+        if (!first) {
+            output << ",";
+        }
+        first = false;
+        printJsonString(output, it.first);
+        output << ":{\"type\":";
+        printJsonString(output, a->typestr());
+        output << ",\"writable\":" << (a->writable() ? "true" : "false");
+        output << ",\"value\":";
+        printJsonString(output, a->str());
+        output << "}";
+    }
+    output << "},\"children\":{";
+    first = true;
+    foreachChild([&output,&first](const string& name, Object* child) {
+        if (!first) {
+            output << ",";
+        }
+        first = false;
+        printJsonString(output, name);
+        output << ":";
+        child->printJson(output);
+    });
+    output << "}}";
+}
+
 Attribute* Object::deepAttribute(const string &path) {
     std::ostringstream output;
     OutputChannels channels("", output, output);
@@ -44,7 +44,7 @@ class Object : public HasDocumentation {
 
 public:
     Object() = default;
-    virtual ~Object() = default;
+    virtual ~Object();
 
     // object tree ls command
     virtual void ls(Output out);
@@ -60,7 +60,7 @@ public:
 
     void addAttribute(Attribute* a);
     void removeAttribute(Attribute* a);
-    std::map<std::string, Attribute*> attributes() { return attribs_; }
+    const std::map<std::string, Attribute*>& attributes() { return attribs_; }
 
     // if a concrete object maintains its index within the parent as an
     // attribute (e.g. monitors and tags do), then they should implement the
@@ -68,6 +68,8 @@ public:
     virtual void setIndexAttribute(unsigned long index) { };
 
     Object* child(const std::string &name);
+    // like child(), but also set 'dynamic' if the child is a dynamic child
+    Object* child(const std::string &name, bool& dynamic);
 
     Object* child(Path path);
 
@@ -91,8 +93,20 @@ public:
     void removeHook(Hook* hook);
 
     std::map<std::string, Object*> children();
+    //! call the visitor for every child in the order of children(),
+    //! but without copying the children. If a prefix is given, then
+    //! only the children whose name starts with the prefix are visited.
+    void foreachChild(std::function<void(const std::string&, Object*)> visitor,
+                      const std::string& prefix = {});
 
     void printTree(Output output, std::string rootLabel);
+    void printJson(std::ostream& output);
+
+    /** a counter that changes whenever the object tree changes
+     * structurally, i.e. whenever a child or an attribute is added or
+     * removed or whenever an object is destroyed.
+     */
+    static unsigned long treeGeneration() { return treeGeneration_; }
 
 protected:
     // initialize an attribute (typically used by init())
@@ -105,6 +119,9 @@ protected:
     std::map<std::string, HasDocumentation*> childrenDoc_;
     std::vector<Hook*> hooks_;
 
+private:
+    static unsigned long treeGeneration_;
+
     //DynamicAttribute nameAttribute_;
 };
 
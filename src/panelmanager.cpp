@@ -1,5 +1,7 @@
 #include "panelmanager.h"
 
+#include <X11/Xatom.h>
+
 #include "settings.h"
 #include "x11-types.h"
 #include "xconnection.h"
@@ -17,9 +19,6 @@ public:
         , pm_(pm)
         , size_(this, "geometry", {})
     {
-        auto hint = pm.xcon_.getClassHint(winid);
-        windowInstance_ = hint.first;
-        windowClass_ = hint.second;
         winid_.setDoc("the ID of the panel window");
         windowInstance_.setDoc("the window instance (first entry of WM_CLASS)");
         windowClass_.setDoc("the window class (second entry of WM_CLASS)");
@@ -100,8 +99,9 @@ PanelManager::PanelManager(XConnection& xcon)
     : count(this, "count", &PanelManager::getCount)
     , xcon_(xcon)
 {
-    atomWmStrut_ = xcon_.atom("_NET_WM_STRUT");
-    atomWmStrutPartial_ = xcon_.atom("_NET_WM_STRUT_PARTIAL");
+    auto atoms = xcon_.internAtoms({ "_NET_WM_STRUT", "_NET_WM_STRUT_PARTIAL" });
+    atomWmStrut_ = atoms[0];
+    atomWmStrutPartial_ = atoms[1];
     rootWindowGeometry_ = xcon_.windowSize(xcon_.root());
     setDoc("For every panel window, there is an entry with "
            "the panel's window id here.");
@@ -116,10 +116,15 @@ PanelManager::~PanelManager()
 
 void PanelManager::registerPanel(Window win)
 {
+    // the replies to all requests for the new panel arrive after only one round-trip
+    auto classHint = xcon_.getClassHintAsync(win);
+    auto geometry = xcon_.windowSizeAsync(win);
     Panel* p = new Panel(win, *this);
     panels_.insert(make_pair(win, p));
     addChild(p, Converter<WindowID>::str(win));
-    updateReservedSpace(p, xcon_.windowSize(win));
+    updateReservedSpace(p, std::move(geometry));
+    p->windowInstance_ = classHint.get().first;
+    p->windowClass_ = classHint.get().second;
     panels_changed_.emit();
 }
 
@@ -144,7 +149,7 @@ void PanelManager::propertyChanged(Window win, Atom property)
     auto it = panels_.find(win);
     if (it != panels_.end()) {
         Panel* p = it->second;
-        if (updateReservedSpace(p, xcon_.windowSize(win))) {
+        if (updateReservedSpace(p, xcon_.windowSizeAsync(win))) {
             panels_changed_.emit();
         }
     }
@@ -161,7 +166,7 @@ void PanelManager::geometryChanged(Window win, Rectangle geometry)
     auto it = panels_.find(win);
     if (it != panels_.end()) {
         Panel* p = it->second;
-        if (updateReservedSpace(p, geometry)) {
+        if (updateReservedSpace(p, XFuture<Rectangle>(geometry))) {
             panels_changed_.emit();
         }
     }
@@ -177,15 +182,21 @@ void PanelManager::injectDependencies(Settings* settings)
 
 /**
  * read the reserved space from the panel window and return if there are changes
- * - size is the geometry of the panel
+ * - geometry is the (possibly not yet received) geometry of the panel
  */
-bool PanelManager::updateReservedSpace(Panel* p, Rectangle size)
+bool PanelManager::updateReservedSpace(Panel* p, XFuture<Rectangle> geometry)
 {
-    auto optionalWmStrut = xcon_.getWindowPropertyCardinal(p->winid_(), atomWmStrutPartial_);
-    if (!optionalWmStrut) {
-        optionalWmStrut= xcon_.getWindowPropertyCardinal(p->winid_(), atomWmStrut_);
+    // request both properties at once, even though _NET_WM_STRUT
+    // is only needed if _NET_WM_STRUT_PARTIAL is not set
+    auto strutPartial = xcon_.getWindowProperty32Async(p->winid_(), atomWmStrutPartial_, XA_CARDINAL);
+    auto strut = xcon_.getWindowProperty32Async(p->winid_(), atomWmStrut_, XA_CARDINAL);
+    vector<long> wmStrut;
+    if (strutPartial.get().has_value()) {
+        wmStrut.assign(strutPartial.get().value().begin(), strutPartial.get().value().end());
+    } else if (strut.get().has_value()) {
+        wmStrut.assign(strut.get().value().begin(), strut.get().value().end());
     }
-    vector<long> wmStrut = optionalWmStrut.value_or(vector<long>());
+    Rectangle size = geometry.get();
     if (p->wmStrut_ != wmStrut || p->size_ != size) {
         p->wmStrut_ = wmStrut;
         p->size_ = size;
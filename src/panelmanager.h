@@ -7,6 +7,7 @@
 #include "object.h"
 #include "rectangle.h"
 #include "signal.h"
+#include "xfuture.h"
 
 class Panel;
 class Settings;
@@ -50,7 +51,7 @@ private:
     unsigned long getCount() {
         return static_cast<unsigned long>(panels_.size());
     };
-    bool updateReservedSpace(Panel* p, Rectangle geometry);
+    bool updateReservedSpace(Panel* p, XFuture<Rectangle> geometry);
 
     std::unordered_map<Window, Panel*> panels_;
     Atom atomWmStrut_;
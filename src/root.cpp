@@ -19,6 +19,8 @@
 #include "tag.h"
 #include "tagmanager.h"
 #include "theme.h"
+#include "timermanager.h"
+#include "timerqueue.h"
 #include "tmp.h"
 #include "typesdoc.h"
 #include "utils.h"
@@ -30,7 +32,8 @@ using std::shared_ptr;
 shared_ptr<Root> Root::root_;
 
 Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer)
-    : autostart(*this, "autostart")
+    : timerQueue_(make_unique<TimerQueue>())
+    , autostart(*this, "autostart")
     , clients(*this, "clients")
     , keys(*this, "keys")
     , monitors(*this, "monitors")
@@ -40,6 +43,7 @@ Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer
     , settings(*this, "settings")
     , tags(*this, "tags")
     , theme(*this, "theme")
+    , timers(*this, "timers")
     , tmp(*this, TMP_OBJECT_PATH)
     , types(*this, "types")
     , watchers(*this, "watchers")
@@ -62,6 +66,7 @@ Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer
     settings.init();
     tags.init();
     theme.init();
+    timers.init(*timerQueue_);
     tmp.init();
     types.init();
     watchers.init();
@@ -117,6 +122,7 @@ void Root::shutdown()
     rules.reset();
     settings.reset();
     theme.reset();
+    timers.reset();
     tmp.reset();
 
     children_.clear(); // avoid possible circular shared_ptr dependency
@@ -24,6 +24,8 @@ class RuleManager; // IWYU pragma: keep
 class Settings; // IWYU pragma: keep
 class TagManager; // IWYU pragma: keep
 class Theme; // IWYU pragma: keep
+class TimerManager; // IWYU pragma: keep
+class TimerQueue;
 class Tmp; // IWYU pragma: keep
 class TypesDoc; // IWYU pragma: keep
 class Watchers;
@@ -55,6 +57,10 @@ public:
     ~Root() override;
     void shutdown();
 
+    //! the timers run by the main loop. This is declared before the
+    //! children, such that it outlives the timers of the TimerManager
+    std::unique_ptr<TimerQueue> timerQueue_;
+
     // (in alphabetical order)
     Child_<Autostart> autostart;
     Child_<ClientManager> clients;
@@ -66,6 +72,7 @@ public:
     Child_<Settings> settings;
     Child_<TagManager> tags;
     Child_<Theme> theme;
+    Child_<TimerManager> timers;
     Child_<Tmp> tmp;
     Child_<TypesDoc> types;
     Child_<Watchers> watchers;
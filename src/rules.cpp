@@ -4,12 +4,9 @@
 #include <cstdio>
 
 #include "client.h"
-#include "ewmh.h"
 #include "globals.h"
 #include "hook.h"
-#include "root.h"
 #include "utils.h"
-#include "xconnection.h"
 
 using std::string;
 using std::function;
@@ -288,11 +285,11 @@ bool Condition::matches(const string& str) const {
 }
 
 bool Condition::matchesClass(const Client* client) const {
-    return matches(Root::get()->X.getClass(client->window_));
+    return matches(client->window_class_());
 }
 
 bool Condition::matchesInstance(const Client* client) const {
-    return matches(Root::get()->X.getInstance(client->window_));
+    return matches(client->window_instance_());
 }
 
 bool Condition::matchesTitle(const Client* client) const {
@@ -331,23 +328,17 @@ bool Condition::matchesMaxage(const Client* client) const {
 }
 
 bool Condition::matchesWindowtype(const Client* client) const {
-    auto& ewmh = Ewmh::get();
-    int wintype = ewmh.getWindowType(client->x11Window());
-    if (wintype < 0) {
+    if (client->windowType_ < 0) {
         return false;
     }
-    return matches(ewmh.netatomName(wintype));
+    return matches(client->window_type_());
 }
 
 bool Condition::matchesWindowrole(const Client* client) const {
-    auto& X = Root::get()->X;
-    auto role = X.getWindowProperty(client->window_, X.atom("WM_WINDOW_ROLE"));
-
-    if (!role.has_value()) {
+    if (!client->hasWindowRole_) {
         return false;
     }
-
-    return matches(role.value());
+    return matches(client->window_role_());
 }
 
 bool Condition::matchesFixedSize(const Client* client) const {
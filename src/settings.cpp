@@ -100,9 +100,12 @@ Settings::Settings()
         &smart_window_surroundings,
         &monitors_locked,
         &auto_detect_monitors,
+        &monitor_detection_delay,
         &auto_detect_panels,
         &pseudotile_center_threshold,
         &update_dragged_clients,
+        &decoration_resize_windows,
+        &title_update_interval,
         &ellipsis,
         &tree_style,
         &wmname,
@@ -367,7 +370,15 @@ Settings::Settings()
 
     auto_detect_monitors.setDoc(
                 "If set, detect_monitors is automatically executed every time "
-                "a monitor is connected, disconnected or resized.");
+                "a monitor is connected, disconnected or resized. A burst of "
+                "such changes, e.g. when docking a laptop, is handled by "
+                "a single detection, see monitor_detection_delay.");
+
+    monitor_detection_delay.setDoc(
+                "The time in milliseconds between the first of a burst of "
+                "monitor changes and the automatic monitor detection if "
+                "auto_detect_monitors is set. All changes within this time "
+                "are handled by the same detection.");
 
     auto_detect_panels.setDoc(
                 "If set, EWMH panels are automatically detected and reserve "
@@ -413,6 +424,18 @@ Settings::Settings()
                 "If set, a client\'s window content is resized immediately "
                 "during resizing it with the mouse. If unset, the client\'s "
                 "content is resized after the mouse button is released.");
+    decoration_resize_windows.setDoc(
+                "If set, every window decoration has invisible sub-windows "
+                "for its resize areas, which define the cursor shape on the "
+                "window border. If unset, the cursor shape is updated by "
+                "herbstluftwm on pointer motion over the decoration, "
+                "which saves some X requests whenever a window is resized.");
+    title_update_interval.setDoc(
+                "The minimum time in milliseconds between two updates of a "
+                "client\'s title. If a client changes its title more often, "
+                "then herbstluftwm reads the title only once per interval, "
+                "and always reads the final title. If 0, then every change "
+                "of the title is read immediately.");
 
     verbose.setDoc(
                 "If set, verbose output is logged to herbstluftwm\'s stderr. "
@@ -517,8 +540,9 @@ int Settings::set_cmd(Input input, Output output) {
 
 void Settings::set_complete(Completion& complete) {
     if (complete == 0) {
-        for (auto& a : attributes()) {
-            complete.full(a.first);
+        auto range = complete.matchingKeys(attributes());
+        for (auto it = range.first; it != range.second; it++) {
+            complete.full(it->first);
         }
     } else if (complete == 1) {
         Attribute* a = attribute(complete[0]);
@@ -578,8 +602,9 @@ int Settings::get_cmd(Input argv, Output output) {
 
 void Settings::get_complete(Completion& complete) {
     if (complete == 0) {
-        for (auto& a : attributes()) {
-            complete.full(a.first);
+        auto range = complete.matchingKeys(attributes());
+        for (auto it = range.first; it != range.second; it++) {
+            complete.full(it->first);
         }
     } else if (complete == 1) {
         Attribute* a = attribute(complete[0]);
@@ -89,9 +89,12 @@ public:
     Attribute_<bool>          smart_window_surroundings = {"smart_window_surroundings", false};
     Attribute_<unsigned long> monitors_locked = {"monitors_locked", 0};
     Attribute_<bool>          auto_detect_monitors = {"auto_detect_monitors", false};
+    Attribute_<unsigned long> monitor_detection_delay = {"monitor_detection_delay", 100};
     Attribute_<bool>          auto_detect_panels = {"auto_detect_panels", true};
     Attribute_<int>           pseudotile_center_threshold = {"pseudotile_center_threshold", 10};
     Attribute_<bool>          update_dragged_clients = {"update_dragged_clients", false};
+    Attribute_<bool>          decoration_resize_windows = {"decoration_resize_windows", true};
+    Attribute_<unsigned long> title_update_interval = {"title_update_interval", 0};
     Attribute_<string>        ellipsis = {"ellipsis", "..."};
     Attribute_<string>        tree_style = {"tree_style", "*| +`--."};
     Attribute_<string>        wmname = {"wmname", WINDOW_MANAGER_NAME};
@@ -10,6 +10,7 @@
 #include "decoration.h"
 #include "ewmh.h"
 #include "floating.h"
+#include "floatingindex.h"
 #include "frametree.h"
 #include "hlwmcommon.h"
 #include "hook.h"
@@ -20,6 +21,7 @@
 #include "settings.h"
 #include "stack.h"
 #include "tagmanager.h"
+#include "tilingresult.h"
 #include "utils.h"
 
 using std::endl;
@@ -52,6 +54,8 @@ HSTag::HSTag(string name_, TagManager* tags, Settings* settings)
     , oldName_(name_)
     , tags_(tags)
     , settings_(settings)
+    , floatingIndex_(make_unique<FloatingIndex>(this))
+    , layoutCache_(make_unique<LayoutCache>())
 {
     stack = make_shared<Stack>();
     frame.init(this, settings);
@@ -62,6 +66,7 @@ HSTag::HSTag(string name_, TagManager* tags, Settings* settings)
         });
     });
     floating.changed().connect(this, &HSTag::onGlobalFloatingChange);
+    needsRelayout_.connect([this]() { floatingIndex_->invalidate(); });
     // FIXME: actually this connection of the signals like this
     // must work:
     //   floating_focused.changedByUser().connect(needsRelayout_);
@@ -122,6 +127,7 @@ void HSTag::applyClientState(Client* client)
     if (!client) {
         return;
     }
+    layoutCache_->invalidate();
     bool focused = client == focusedClient();
     if (focused) {
         // make it that client stays focused
@@ -167,6 +173,7 @@ void HSTag::applyClientState(Client* client)
 void HSTag::setVisible(bool newVisible)
 {
     visible = newVisible;
+    floatingIndex_->invalidate();
     // always pass the visibility state correctly
     // to the clients, even though the state of
     // `visible` may not have changed.
@@ -181,6 +188,8 @@ void HSTag::setVisible(bool newVisible)
 }
 
 bool HSTag::removeClient(Client* client) {
+    floatingIndex_->invalidate();
+    layoutCache_->invalidate();
     // remove 'client' from the tab bars of all other clients
     foreachClient([client](Client* remainingClient) {
         if (remainingClient != client) {
@@ -283,6 +292,8 @@ Client *HSTag::focusedClient()
 
 void HSTag::insertClient(Client* client, string frameIndex, bool focus)
 {
+    floatingIndex_->invalidate();
+    layoutCache_->invalidate();
     if (client->floating_() || client->minimized_()) {
         floating_clients_.push_back(client);
         if (focus && !client->minimized_()) {
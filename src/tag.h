@@ -20,8 +20,10 @@ enum {
 enum class DirectionLevel;
 class Client;
 class Completion;
+class FloatingIndex;
 class FrameLeaf;
 class FrameTree;
+class LayoutCache;
 class Settings;
 class Stack;
 class TagManager;
@@ -48,6 +50,10 @@ public:
     // focused if this tag hasVisibleFloatingClients()
     size_t               floating_clients_focus_; //! focus in the floating clients
     std::shared_ptr<Stack> stack;
+    //! the spatial index of the visible clients for directional commands
+    FloatingIndex& floatingIndex() { return *floatingIndex_; }
+    //! the layout that was applied to the clients most recently
+    LayoutCache& layoutCache() { return *layoutCache_; }
     void setIndexAttribute(unsigned long new_index) override;
     bool focusClient(Client* client);
     void applyClientState(Client* client);
@@ -96,6 +102,8 @@ private:
     int countUrgentClients();
     TagManager* tags_;
     Settings* settings_;
+    std::unique_ptr<FloatingIndex> floatingIndex_;
+    std::unique_ptr<LayoutCache> layoutCache_;
 };
 
 // for tags
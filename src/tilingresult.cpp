@@ -1,6 +1,7 @@
 #include "tilingresult.h"
 
 using std::make_pair;
+using std::map;
 
 TilingStep::TilingStep(Rectangle rect)
     : geometry(rect)
@@ -19,3 +20,35 @@ void TilingResult::mergeFrom(TilingResult& other) {
     data.splice(data.end(), other.data);
     frames.splice(frames.end(), other.frames);
 }
+
+bool AppliedStep::operator==(const AppliedStep& other) const
+{
+    return geometry == other.geometry
+        && floatGeometry == other.floatGeometry
+        && floated == other.floated
+        && fullscreen == other.fullscreen
+        && focused == other.focused
+        && minimalDecoration == other.minimalDecoration
+        && tabs == other.tabs;
+}
+
+//! whether the cached steps can be compared to a layout of the given area
+bool LayoutCache::reusable(Rectangle area, bool focused) const
+{
+    return valid_ && area_ == area && focused_ == focused;
+}
+
+//! whether the client was resized with the given step most recently
+bool LayoutCache::unchanged(Client* client, const AppliedStep& step) const
+{
+    auto it = steps_.find(client);
+    return it != steps_.end() && it->second == step;
+}
+
+void LayoutCache::store(Rectangle area, bool focused, map<Client*, AppliedStep> steps)
+{
+    valid_ = true;
+    area_ = area;
+    focused_ = focused;
+    steps_.swap(steps);
+}
@@ -2,6 +2,7 @@
 #define __HLWM_TILINGSTEP_H_
 
 #include <list>
+#include <map>
 
 #include "framedecoration.h"
 #include "x11-types.h"
@@ -40,5 +41,37 @@ public:
     std::list<std::pair<Client*,TilingStep>> data;
 };
 
+// the parameters with which Monitor::applyLayout() last resized a client
+class AppliedStep {
+public:
+    bool operator==(const AppliedStep& other) const;
+    bool operator!=(const AppliedStep& other) const { return !(*this == other); }
+    Rectangle geometry = {};
+    Rectangle floatGeometry = {};
+    bool floated = false;
+    bool fullscreen = false;
+    bool focused = false;
+    bool minimalDecoration = false;
+    std::vector<Client*> tabs = {};
+};
+
+/**
+ * @brief The layout that was applied to the clients of a tag most
+ * recently. While the tag is hidden and unchanged, its windows keep
+ * these geometries, so when the tag is shown again on the same area,
+ * only those clients need to be resized whose step differs.
+ */
+class LayoutCache {
+public:
+    void invalidate() { valid_ = false; }
+    bool reusable(Rectangle area, bool focused) const;
+    bool unchanged(Client* client, const AppliedStep& step) const;
+    void store(Rectangle area, bool focused, std::map<Client*, AppliedStep> steps);
+private:
+    bool valid_ = false;
+    Rectangle area_ = {};
+    bool focused_ = false;
+    std::map<Client*, AppliedStep> steps_;
+};
 
 #endif
@@ -0,0 +1,124 @@
+#include "timermanager.h"
+
+#include <iostream>
+#include <sstream>
+
+#include "argparse.h"
+#include "command.h"
+#include "completion.h"
+#include "ipc-protocol.h"
+
+using std::string;
+using std::vector;
+
+TimerManager::TimerManager(TimerQueue& timerQueue)
+    : count_(this, "count", &TimerManager::count)
+    , timerQueue_(timerQueue)
+{
+    count_.setDoc("the number of timers created by the \'timer\' command");
+}
+
+TimerManager::~TimerManager()
+{
+    for (const auto& it : timers_) {
+        timerQueue_.remove(it.second.id_);
+    }
+}
+
+void TimerManager::timerCommand(CallOrComplete invoc)
+{
+    string label;
+    unsigned long milliseconds = 0;
+    bool periodic = false;
+    ArgParse ap;
+    ap.mandatory(label).mandatory(milliseconds, {"100", "1000"});
+    ap.flags({
+        {"--periodic", &periodic},
+    });
+    ap.command(invoc,
+               [&](Completion& complete) {
+        complete.completeCommands(0);
+    },
+               [&](ArgList command, Output output) -> int {
+        if (command.empty()) {
+            return HERBST_NEED_MORE_ARGS;
+        }
+        if (label.empty()) {
+            output.perror() << "the label must not be empty\n";
+            return HERBST_INVALID_ARGUMENT;
+        }
+        if (periodic && milliseconds == 0) {
+            output.perror() << "the interval of a periodic timer must be positive\n";
+            return HERBST_INVALID_ARGUMENT;
+        }
+        // a timer with the same label is replaced
+        removeTimer(label);
+        UserTimer& timer = timers_[label];
+        timer.command_ = vector<string>(command.begin(), command.end());
+        timer.periodic_ = periodic;
+        auto interval = std::chrono::milliseconds(milliseconds);
+        timer.id_ = timerQueue_.add(interval, [this, label]() { fire(label); },
+                                    periodic ? interval : TimerQueue::Clock::duration::zero());
+        return 0;
+    });
+}
+
+void TimerManager::fire(const string& label)
+{
+    auto it = timers_.find(label);
+    if (it == timers_.end()) {
+        return;
+    }
+    // the command may remove or replace the timer itself
+    vector<string> cmd = it->second.command_;
+    if (!it->second.periodic_) {
+        timers_.erase(it);
+    }
+    std::ostringstream discardedOutput;
+    Input input(cmd.front(), {cmd.begin() + 1, cmd.end()});
+    // discard output, but forward errors to std::cerr
+    OutputChannels channels(cmd.front(), discardedOutput, std::cerr);
+    Commands::call(input, channels);
+}
+
+void TimerManager::removeTimer(const string& label)
+{
+    auto it = timers_.find(label);
+    if (it == timers_.end()) {
+        return;
+    }
+    timerQueue_.remove(it->second.id_);
+    timers_.erase(it);
+}
+
+int TimerManager::untimerCommand(Input input, Output output)
+{
+    string label;
+    if (!(input >> label)) {
+        return HERBST_NEED_MORE_ARGS;
+    }
+    if (label == "--all" || label == "-F") {
+        while (!timers_.empty()) {
+            removeTimer(timers_.begin()->first);
+        }
+        return 0;
+    }
+    if (timers_.find(label) == timers_.end()) {
+        output.perror() << "there is no timer with label \"" << label << "\"\n";
+        return HERBST_INVALID_ARGUMENT;
+    }
+    removeTimer(label);
+    return 0;
+}
+
+void TimerManager::untimerCompletion(Completion& complete)
+{
+    if (complete == 0) {
+        complete.full({ "-F", "--all" });
+        for (const auto& it : timers_) {
+            complete.full(it.first);
+        }
+    } else {
+        complete.none();
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "attribute_.h"
+#include "object.h"
+#include "timerqueue.h"
+
+class CallOrComplete;
+class Completion;
+
+/**
+ * @brief The timers created by the user via the 'timer' command,
+ * each of which runs a command after a delay or periodically.
+ */
+class TimerManager : public Object {
+public:
+    TimerManager(TimerQueue& timerQueue);
+    ~TimerManager() override;
+
+    DynAttribute_<unsigned long> count_;
+
+    void timerCommand(CallOrComplete invoc);
+    int untimerCommand(Input input, Output output);
+    void untimerCompletion(Completion& complete);
+private:
+    class UserTimer {
+    public:
+        std::vector<std::string> command_;
+        bool periodic_ = false;
+        TimerQueue::TimerId id_ = 0;
+    };
+    unsigned long count() const { return timers_.size(); }
+    void fire(const std::string& label);
+    void removeTimer(const std::string& label);
+    TimerQueue& timerQueue_;
+    //! the timers by their labels
+    std::map<std::string, UserTimer> timers_;
+};
@@ -0,0 +1,86 @@
+#include "timerqueue.h"
+
+#include <algorithm>
+
+using std::function;
+using std::make_pair;
+using std::vector;
+
+TimerQueue::TimerId TimerQueue::add(Clock::duration delay, function<void()> callback,
+                                    Clock::duration period)
+{
+    TimerId id = nextId_++;
+    Clock::time_point due = Clock::now() + delay;
+    timers_[id] = { due, period, callback };
+    push(id, due);
+    return id;
+}
+
+void TimerQueue::remove(TimerId id)
+{
+    timers_.erase(id);
+    // if many timers have been removed, then drop their heap entries
+    if (heap_.size() > 2 * timers_.size() + 16) {
+        vector<HeapEntry> entries;
+        entries.reserve(timers_.size());
+        for (const auto& it : timers_) {
+            entries.push_back(make_pair(it.second.due_, it.first));
+        }
+        heap_ = decltype(heap_)(std::greater<HeapEntry>(), std::move(entries));
+    }
+}
+
+void TimerQueue::push(TimerId id, Clock::time_point due)
+{
+    heap_.push(make_pair(due, id));
+}
+
+bool TimerQueue::isValid(const HeapEntry& entry)
+{
+    auto it = timers_.find(entry.second);
+    return it != timers_.end() && it->second.due_ == entry.first;
+}
+
+bool TimerQueue::runDue()
+{
+    // timers added by the callbacks are due after 'now' and so
+    // they are only run on the next call
+    Clock::time_point now = Clock::now();
+    bool ranAny = false;
+    while (!heap_.empty() && heap_.top().first <= now) {
+        HeapEntry entry = heap_.top();
+        heap_.pop();
+        if (!isValid(entry)) {
+            continue;
+        }
+        Timer& timer = timers_[entry.second];
+        // the callback may remove its own timer, so copy it
+        function<void()> callback = timer.callback_;
+        if (timer.period_ > Clock::duration::zero()) {
+            timer.due_ += timer.period_;
+            if (timer.due_ <= now) {
+                // if the periods were missed, then do not run the
+                // callback for each of them
+                timer.due_ = now + timer.period_;
+            }
+            push(entry.second, timer.due_);
+        } else {
+            timers_.erase(entry.second);
+        }
+        callback();
+        ranAny = true;
+    }
+    return ranAny;
+}
+
+std::experimental::optional<TimerQueue::Clock::duration> TimerQueue::timeUntilNext()
+{
+    while (!heap_.empty() && !isValid(heap_.top())) {
+        heap_.pop();
+    }
+    if (heap_.empty()) {
+        return {};
+    }
+    Clock::duration remaining = heap_.top().first - Clock::now();
+    return std::max(remaining, Clock::duration::zero());
+}
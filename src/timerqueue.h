@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "optional.h"
+
+/**
+ * @brief The timers of the main loop, kept in a min-heap ordered by
+ * the time when they are due. The main loop waits for X events at most
+ * until the next timer is due and then runs the due timers.
+ */
+class TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = unsigned long;
+    /**
+     * @brief run the callback once the delay has passed. If the period
+     * is positive, then it is run again after each period, until the
+     * timer is removed.
+     * @return the id to remove the timer
+     */
+    TimerId add(Clock::duration delay, std::function<void()> callback,
+                Clock::duration period = Clock::duration::zero());
+    void remove(TimerId id);
+    bool empty() const { return timers_.empty(); }
+    //! run the callbacks of all due timers and return whether there were any
+    bool runDue();
+    //! the time until the next timer is due, if there is any timer
+    std::experimental::optional<Clock::duration> timeUntilNext();
+private:
+    class Timer {
+    public:
+        Clock::time_point due_;
+        Clock::duration period_;
+        std::function<void()> callback_;
+    };
+    using HeapEntry = std::pair<Clock::time_point, TimerId>;
+    void push(TimerId id, Clock::time_point due);
+    //! whether the heap entry still belongs to an existing timer
+    bool isValid(const HeapEntry& entry);
+    std::unordered_map<TimerId, Timer> timers_;
+    //! the due time of every timer. Removed timers are not removed
+    //! from the heap immediately, but skipped later
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap_;
+    TimerId nextId_ = 1;
+};
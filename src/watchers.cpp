@@ -6,6 +6,7 @@
 #include "metacommands.h"
 #include "object.h"
 
+using std::make_pair;
 using std::string;
 
 Watchers::Watchers()
@@ -22,14 +23,15 @@ void Watchers::injectDependencies(Object* root)
 void Watchers::scanForChanges()
 {
     for (auto& it : lastValue_) {
-        Attribute* attr = root_->deepAttribute(it.first);
+        Attribute* attr = it.second.first.resolve(*root_);
         string newValue = "";
         if (attr) {
             newValue = attr->str();
         }
-        if (newValue != it.second) {
-            hook_emit({"attribute_changed", it.first, it.second, newValue});
-            it.second = newValue;
+        string& lastValue = it.second.second;
+        if (newValue != lastValue) {
+            hook_emit({"attribute_changed", it.first, lastValue, newValue});
+            lastValue = newValue;
         }
     }
 }
@@ -41,12 +43,14 @@ int Watchers::watchCommand(Input input, Output output)
     if (args.parsingAllFails(input, output)) {
         return args.exitCode();
     }
+    AttributePath compiledPath(path);
     string value = "";
-    Attribute* attr = root_->deepAttribute(path);
+    Attribute* attr = compiledPath.resolve(*root_);
     if (attr) {
         value = attr->str();
     }
-    lastValue_[path] = value;
+    lastValue_.erase(path);
+    lastValue_.emplace(path, make_pair(compiledPath, value));
     return 0;
 }
 
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "attribute_.h"
+#include "attributepath.h"
 #include "converter.h"
 #include "object.h"
 
@@ -22,5 +23,6 @@ public:
 private:
     unsigned long count() const { return lastValue_.size(); }
     Object* root_ = nullptr;
-    std::map<std::string, std::string> lastValue_;
+    //! the compiled path and the last value of each watched attribute
+    std::map<std::string, std::pair<AttributePath, std::string>> lastValue_;
 };
@@ -1,13 +1,17 @@
 #include "xconnection.h"
 
 #include <X11/Xatom.h>
+#include <X11/Xlib-xcb.h>
 #include <X11/Xlib.h>
 #include <X11/Xproto.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/Xrender.h>
 #include <fcntl.h>
+#include <xcb/xcb.h>
+#include <xcb/xproto.h>
 #include <unistd.h>
 #include <climits>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 
@@ -28,12 +32,16 @@ void XConnection::setExitOnError(bool exitOnError)
 }
 
 XConnection::XConnection(Display* disp)
-    : m_display(disp) {
+    : m_display(disp)
+    , xcb_(XGetXCBConnection(disp))
+{
     m_screen = DefaultScreen(m_display);
     m_screen_width = DisplayWidth(m_display, m_screen);
     m_screen_height = DisplayHeight(m_display, m_screen);
     m_root = RootWindow(m_display, m_screen);
-    utf8StringAtom_ = XInternAtom(m_display, "UTF8_STRING", False);
+    // intern the atoms used frequently by the XConnection itself
+    internAtoms({ "UTF8_STRING", "_NET_WM_PID", "WM_WINDOW_ROLE" });
+    utf8StringAtom_ = atom("UTF8_STRING");
     visual_ = DefaultVisual(m_display, m_screen);
     depth_ = DefaultDepth(m_display, m_screen);
     colormap_ = DefaultColormap(m_display, m_screen);
@@ -228,6 +236,31 @@ void XConnection::setCompositorRunning(bool running)
     compositorRunning_ = running;
 }
 
+/**
+ * @brief grab the X server. This can be nested, e.g. for
+ * batching multiple operations that grab the server on their own
+ * into one grab.
+ */
+void XConnection::grabServer()
+{
+    if (serverGrabDepth_ == 0) {
+        XGrabServer(m_display);
+    }
+    serverGrabDepth_++;
+}
+
+void XConnection::ungrabServer()
+{
+    if (serverGrabDepth_ <= 0) {
+        HSDebug("ungrabServer() called without grabServer()\n");
+        return;
+    }
+    serverGrabDepth_--;
+    if (serverGrabDepth_ == 0) {
+        XUngrabServer(m_display);
+    }
+}
+
 Rectangle XConnection::windowSize(Window window) {
     unsigned int border = 0, depth = 0;
     int x = 0, y = 0;
@@ -238,7 +271,45 @@ Rectangle XConnection::windowSize(Window window) {
 }
 
 Atom XConnection::atom(const char* atom_name) {
-    return XInternAtom(m_display, atom_name, False);
+    auto it = atoms_.find(atom_name);
+    if (it != atoms_.end()) {
+        return it->second;
+    }
+    Atom atom = XInternAtom(m_display, atom_name, False);
+    atoms_[atom_name] = atom;
+    return atom;
+}
+
+vector<Atom> XConnection::internAtoms(const vector<string>& names)
+{
+    vector<Atom> result(names.size(), None);
+    // only ask the X server for the atoms not in the table yet
+    vector<char*> missingNames;
+    vector<size_t> missingIndices;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i].empty()) {
+            continue;
+        }
+        auto it = atoms_.find(names[i]);
+        if (it != atoms_.end()) {
+            result[i] = it->second;
+        } else {
+            missingNames.push_back(const_cast<char*>(names[i].c_str()));
+            missingIndices.push_back(i);
+        }
+    }
+    if (missingNames.empty()) {
+        return result;
+    }
+    vector<Atom> missingAtoms(missingNames.size(), None);
+    XInternAtoms(m_display, missingNames.data(), static_cast<int>(missingNames.size()),
+                 False, missingAtoms.data());
+    for (size_t i = 0; i < missingIndices.size(); i++) {
+        size_t idx = missingIndices[i];
+        result[idx] = missingAtoms[i];
+        atoms_[names[idx]] = missingAtoms[i];
+    }
+    return result;
 }
 
 
@@ -317,7 +388,7 @@ std::experimental::optional<string> XConnection::getWindowProperty(Window window
 }
 
 //! implement XChangeProperty for type=ATOM('UTF8_STRING')
-void XConnection::setPropertyString(Window w, Atom property, string value) {
+void XConnection::setPropertyString(Window w, Atom property, const string& value) {
     // according to the XChangeProperty-specification:
     // if format = 8, then the data must be a char array.
     XChangeProperty(m_display, w, property,
@@ -360,6 +431,13 @@ void XConnection::setPropertyWindow(Window w, Atom property, const vector<Window
         (unsigned char*)(value.data()), value.size());
 }
 
+//! append to a property of type=XA_WINDOW without sending the existing entries again
+void XConnection::appendPropertyWindow(Window w, Atom property, const vector<Window>& value) {
+    XChangeProperty(m_display, w, property,
+        XA_WINDOW, 32, PropModeAppend,
+        (unsigned char*)(value.data()), value.size());
+}
+
 //! implement XChangeProperty for type=XA_CARDINAL
 void XConnection::setPropertyCardinal(Window w, Atom property, const vector<long>& value) {
     // according to the XChangeProperty-specification:
@@ -541,6 +619,185 @@ vector<Window> XConnection::queryTree(Window window) {
     return result;
 }
 
+//! wait for the reply to a GetProperty request, nullptr on errors
+static xcb_get_property_reply_t* propertyReply(xcb_connection_t* xcb,
+                                               xcb_get_property_cookie_t cookie)
+{
+    xcb_generic_error_t* error = nullptr;
+    xcb_get_property_reply_t* reply = xcb_get_property_reply(xcb, cookie, &error);
+    // errors like BadWindow are expected for windows
+    // that have been destroyed meanwhile
+    free(error);
+    return reply;
+}
+
+XFuture<std::experimental::optional<XConnection::WindowState>>
+    XConnection::getWindowStateAsync(Window window)
+{
+    xcb_connection_t* xcb = xcb_;
+    auto cookie = xcb_get_window_attributes(xcb, window);
+    return {
+        [xcb, cookie]() -> std::experimental::optional<WindowState> {
+            xcb_generic_error_t* error = nullptr;
+            xcb_get_window_attributes_reply_t* reply =
+                xcb_get_window_attributes_reply(xcb, cookie, &error);
+            free(error);
+            if (!reply) {
+                return {};
+            }
+            WindowState state;
+            state.overrideRedirect = reply->override_redirect;
+            state.viewable = reply->map_state == XCB_MAP_STATE_VIEWABLE;
+            free(reply);
+            return state;
+        },
+        [xcb, cookie]() { xcb_discard_reply(xcb, cookie.sequence); }
+    };
+}
+
+//! like windowSize(), i.e. the geometry is all zeros on errors
+XFuture<Rectangle> XConnection::windowSizeAsync(Window window)
+{
+    xcb_connection_t* xcb = xcb_;
+    auto cookie = xcb_get_geometry(xcb, window);
+    return {
+        [xcb, cookie]() {
+            xcb_generic_error_t* error = nullptr;
+            xcb_get_geometry_reply_t* reply = xcb_get_geometry_reply(xcb, cookie, &error);
+            free(error);
+            if (!reply) {
+                return Rectangle();
+            }
+            Rectangle geometry = { reply->x, reply->y, reply->width, reply->height };
+            free(reply);
+            return geometry;
+        },
+        [xcb, cookie]() { xcb_discard_reply(xcb, cookie.sequence); }
+    };
+}
+
+XFuture<std::experimental::optional<vector<unsigned long>>>
+    XConnection::getWindowProperty32Async(Window window, Atom property, Atom type)
+{
+    xcb_connection_t* xcb = xcb_;
+    auto cookie = xcb_get_property(xcb, 0, window, property, type, 0, UINT_MAX / 4);
+    return {
+        [xcb, cookie, type]() -> std::experimental::optional<vector<unsigned long>> {
+            xcb_get_property_reply_t* reply = propertyReply(xcb, cookie);
+            if (!reply || reply->type != type || reply->format != 32) {
+                free(reply);
+                return {};
+            }
+            uint32_t* items = static_cast<uint32_t*>(xcb_get_property_value(reply));
+            int count = xcb_get_property_value_length(reply) / 4;
+            vector<unsigned long> result(items, items + count);
+            free(reply);
+            return result;
+        },
+        [xcb, cookie]() { xcb_discard_reply(xcb, cookie.sequence); }
+    };
+}
+
+XFuture<std::experimental::optional<string>>
+    XConnection::getWindowPropertyAsync(Window window, Atom property)
+{
+    xcb_connection_t* xcb = xcb_;
+    auto cookie = xcb_get_property(xcb, 0, window, property,
+                                   XCB_GET_PROPERTY_TYPE_ANY, 0, UINT_MAX / 4);
+    return {
+        [this, xcb, cookie, window, property]() -> std::experimental::optional<string> {
+            xcb_get_property_reply_t* reply = propertyReply(xcb, cookie);
+            if (!reply || reply->type == XCB_NONE || reply->format == 0) {
+                free(reply);
+                return {};
+            }
+            Atom type = reply->type;
+            if (reply->format != 8 || (type != XA_STRING && type != utf8StringAtom_)) {
+                // other encodings like COMPOUND_TEXT are rare, so let
+                // the synchronous version do the conversion via Xlib
+                free(reply);
+                return getWindowProperty(window, property);
+            }
+            const char* data = static_cast<const char*>(xcb_get_property_value(reply));
+            int length = xcb_get_property_value_length(reply);
+            // only the first entry of the text list
+            string value(data, strnlen(data, length));
+            free(reply);
+            if (type == XA_STRING) {
+                // a XA_STRING is always encoded in ISO 8859-1
+                return iso_8859_1_to_utf8(value.c_str());
+            }
+            return value;
+        },
+        [xcb, cookie]() { xcb_discard_reply(xcb, cookie.sequence); }
+    };
+}
+
+//! like getClassHint(), i.e. the instance and class name in WM_CLASS
+XFuture<pair<string, string>> XConnection::getClassHintAsync(Window window)
+{
+    xcb_connection_t* xcb = xcb_;
+    auto cookie = xcb_get_property(xcb, 0, window, XA_WM_CLASS, XA_STRING,
+                                   0, UINT_MAX / 4);
+    return {
+        [xcb, cookie]() -> pair<string, string> {
+            xcb_get_property_reply_t* reply = propertyReply(xcb, cookie);
+            if (!reply || reply->type != XA_STRING || reply->format != 8) {
+                free(reply);
+                return {"", ""};
+            }
+            const char* data = static_cast<const char*>(xcb_get_property_value(reply));
+            size_t length = xcb_get_property_value_length(reply);
+            // the two names are separated by a null byte
+            size_t instanceLength = strnlen(data, length);
+            string instance(data, instanceLength);
+            string windowClass;
+            if (instanceLength < length) {
+                const char* classStart = data + instanceLength + 1;
+                windowClass = string(classStart, strnlen(classStart, length - instanceLength - 1));
+            }
+            free(reply);
+            return make_pair(instance, windowClass);
+        },
+        [xcb, cookie]() { xcb_discard_reply(xcb, cookie.sequence); }
+    };
+}
+
+vector<std::experimental::optional<XConnection::WindowState>>
+    XConnection::getWindowStateBatch(const vector<Window>& windows)
+{
+    // first send all requests
+    vector<XFuture<std::experimental::optional<WindowState>>> replies;
+    replies.reserve(windows.size());
+    for (Window win : windows) {
+        replies.push_back(getWindowStateAsync(win));
+    }
+    // and then collect the replies
+    vector<std::experimental::optional<WindowState>> result;
+    result.reserve(windows.size());
+    for (auto& reply : replies) {
+        result.push_back(reply.get());
+    }
+    return result;
+}
+
+vector<std::experimental::optional<vector<unsigned long>>>
+    XConnection::getWindowProperty32Batch(const vector<Window>& windows,
+                                          Atom property, Atom type)
+{
+    vector<XFuture<std::experimental::optional<vector<unsigned long>>>> replies;
+    replies.reserve(windows.size());
+    for (Window win : windows) {
+        replies.push_back(getWindowProperty32Async(win, property, type));
+    }
+    vector<std::experimental::optional<vector<unsigned long>>> result;
+    result.reserve(windows.size());
+    for (auto& reply : replies) {
+        result.push_back(reply.get());
+    }
+    return result;
+}
+
 #define RequestCodeAndString(C)  { C, #C }
 const char* XConnection::requestCodeToString(int requestCode)
 {
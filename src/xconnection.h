@@ -4,11 +4,15 @@
 #include <X11/X.h>
 #include <X11/Xlib.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "optional.h"
 #include "rectangle.h"
+#include "xfuture.h"
 
 class Color;
+struct xcb_connection_t;
 
 class XConnection {
 private:
@@ -27,6 +31,9 @@ public:
     Colormap colormap() { return colormap_; }
     int depth() { return depth_; }
     Visual* visual() { return visual_; }
+    //! the xcb connection underlying the Xlib display, used for
+    //! requests that are sent without waiting for each reply
+    xcb_connection_t* xcb() { return xcb_; }
 
     unsigned long allocColor(Colormap maybeColormap, const Color& color);
 
@@ -35,6 +42,11 @@ public:
     bool usesTransparency() { return usesTransparency_; }
     void setCompositorRunning(bool running);
 
+    // server grabs, which may be nested: only the outermost pair
+    // is sent to the X server
+    void grabServer();
+    void ungrabServer();
+
     // utility functions
     static const char* requestCodeToString(int requestCode);
     static const char* focusChangedDetailToString(int focusedChangedEventDetail);
@@ -42,7 +54,11 @@ public:
     Rectangle windowSize(Window window);
     int windowPid(Window window);
     int windowPgid(Window window);
+    //! the atom with the given name. Atoms are only interned
+    //! once and then looked up in the atom table.
     Atom atom(const char* atom_name);
+    //! intern all the given atoms with only one round-trip
+    std::vector<Atom> internAtoms(const std::vector<std::string>& names);
     std::string atomName(Atom atomIdentifier);
     std::pair<std::string, std::string> getClassHint(Window win);
     std::string getInstance(Window win) { return getClassHint(win).first; };
@@ -56,27 +72,63 @@ public:
         getWindowPropertyWindow(Window window, Atom property);
     std::experimental::optional<std::vector<std::string>>
         getWindowPropertyTextList(Window window, Atom property);
-    void setPropertyString(Window w, Atom property, std::string value);
+    void setPropertyString(Window w, Atom property, const std::string& value);
     void setPropertyString(Window w, Atom property, const std::vector<std::string>& value);
     void setPropertyWindow(Window w, Atom property, const std::vector<Window>& value);
+    void appendPropertyWindow(Window w, Atom property, const std::vector<Window>& value);
     void setPropertyCardinal(Window w, Atom property, const std::vector<long>& value);
     void deleteProperty(Window w, Atom property);
     std::experimental::optional<Window> getTransientForHint(Window win);
     std::vector<Window> queryTree(Window window);
+
+    //! the window attributes that are needed before managing a window
+    class WindowState {
+    public:
+        bool overrideRedirect = false;
+        bool viewable = false;
+    };
+    /** The asynchronous functions only send the request and return
+     * a future for its reply, so the caller can send further requests
+     * before waiting for any of the replies. Errors (e.g. a window that
+     * has been destroyed meanwhile) lead to empty values.
+     */
+    XFuture<std::experimental::optional<WindowState>>
+        getWindowStateAsync(Window window);
+    XFuture<Rectangle> windowSizeAsync(Window window);
+    XFuture<std::experimental::optional<std::vector<unsigned long>>>
+        getWindowProperty32Async(Window window, Atom property, Atom type);
+    //! the first entry of a text property, like getWindowProperty()
+    XFuture<std::experimental::optional<std::string>>
+        getWindowPropertyAsync(Window window, Atom property);
+    XFuture<std::pair<std::string, std::string>> getClassHintAsync(Window window);
+    /** The batch functions send the requests for all windows at once and
+     * only then wait for the replies, so there is only one round-trip
+     * for all the windows. The entry for a window is empty if the window
+     * does not exist (anymore) or if its property has a different type.
+     */
+    std::vector<std::experimental::optional<WindowState>>
+        getWindowStateBatch(const std::vector<Window>& windows);
+    std::vector<std::experimental::optional<std::vector<unsigned long>>>
+        getWindowProperty32Batch(const std::vector<Window>& windows,
+                                 Atom property, Atom type);
     static void setExitOnError(bool exitOnError);
 private:
     static int xerror(Display *dpy, XErrorEvent *ee);
     Display* m_display;
+    xcb_connection_t* xcb_;
     int      m_screen;
     Window   m_root;
     int      m_screen_width;
     int      m_screen_height;
     Atom     utf8StringAtom_;
+    //! the atoms that are interned already
+    std::unordered_map<std::string, Atom> atoms_;
     int depth_;
     Visual* visual_;
     Colormap colormap_;
     bool usesTransparency_ = false;
     bool compositorRunning_ = false;
+    int serverGrabDepth_ = 0;
     static bool     exitOnError_; //! exit on any xlib error
     static XConnection* s_connection;
 };
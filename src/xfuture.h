@@ -0,0 +1,63 @@
+#ifndef __HLWM_XFUTURE_H_
+#define __HLWM_XFUTURE_H_
+
+#include <functional>
+#include <utility>
+
+#include "optional.h"
+
+/**
+ * @brief The reply to a request that was sent to the X server already
+ * but that is only waited for when its value is needed. So one can send
+ * several requests first and then wait for all of them at once, paying
+ * for only one round-trip.
+ *
+ * If the value is never asked for, then the reply is discarded
+ * when the future is destroyed.
+ */
+template<typename T>
+class XFuture {
+public:
+    /**
+     * @param waitForReply blocks until the reply is there and returns its value
+     * @param discardReply tells the connection that the reply is not needed
+     */
+    XFuture(std::function<T()> waitForReply, std::function<void()> discardReply)
+        : waitForReply_(waitForReply)
+        , discardReply_(discardReply)
+    {
+    }
+    //! a future whose value is known already
+    XFuture(const T& value)
+        : value_(value)
+    {
+    }
+    XFuture(XFuture&& other)
+        : waitForReply_(std::move(other.waitForReply_))
+        , discardReply_(std::move(other.discardReply_))
+        , value_(std::move(other.value_))
+    {
+        other.waitForReply_ = nullptr;
+        other.discardReply_ = nullptr;
+    }
+    XFuture(const XFuture&) = delete;
+    XFuture& operator=(const XFuture&) = delete;
+    ~XFuture() {
+        if (!value_.has_value() && discardReply_) {
+            discardReply_();
+        }
+    }
+    //! wait for the reply if this did not happen yet, and return its value
+    const T& get() {
+        if (!value_.has_value()) {
+            value_ = waitForReply_();
+        }
+        return value_.value();
+    }
+private:
+    std::function<T()> waitForReply_;
+    std::function<void()> discardReply_;
+    std::experimental::optional<T> value_;
+};
+
+#endif
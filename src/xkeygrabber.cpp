@@ -4,8 +4,8 @@
 #include <X11/XKBlib.h>
 #include <X11/Xlib.h>
 #include <X11/keysym.h>
+#include <algorithm>
 
-#include "root.h"
 #include "xconnection.h"
 
 using std::vector;
@@ -154,25 +154,40 @@ void XKeyGrabber::setKeyComboCount(const KeyCombo& x11KeyCombo, int newCount)
 }
 
 
-vector<string> XKeyGrabber::getPossibleKeySyms() {
-    vector<string> ret;
+const vector<string>& XKeyGrabber::getPossibleKeySyms() {
+    if (possibleKeySymsValid_) {
+        return possibleKeySyms_;
+    }
+    possibleKeySyms_.clear();
     int min, max;
-    XConnection& X = Root::get()->X;
-    XDisplayKeycodes(X.display(), &min, &max);
+    XDisplayKeycodes(X_.display(), &min, &max);
     int kc_count = max - min + 1;
     int ks_per_kc; // count of keysysms per keycode
     KeySym* keysyms;
-    keysyms = XGetKeyboardMapping(X.display(), min, kc_count, &ks_per_kc);
+    keysyms = XGetKeyboardMapping(X_.display(), min, kc_count, &ks_per_kc);
     // only symbols at a position i*ks_per_kc are symbols that are recieved in
     // a keyevent, it should be the symbol for the keycode if no modifier is
     // pressed
     for (int i = 0; i < kc_count; i++) {
         if (keysyms[i * ks_per_kc] != NoSymbol) {
             char* str = XKeysymToString(keysyms[i * ks_per_kc]);
-            ret.push_back(str);
+            if (str) {
+                possibleKeySyms_.push_back(str);
+            }
         }
     }
     XFree(keysyms);
+    // sort it such that the completion can search for prefixes
+    std::sort(possibleKeySyms_.begin(), possibleKeySyms_.end());
+    possibleKeySyms_.erase(
+        std::unique(possibleKeySyms_.begin(), possibleKeySyms_.end()),
+        possibleKeySyms_.end());
+    possibleKeySymsValid_ = true;
+    return possibleKeySyms_;
+}
 
-    return ret;
+void XKeyGrabber::keyboardMappingChanged()
+{
+    possibleKeySymsValid_ = false;
+    possibleKeySyms_.clear();
 }
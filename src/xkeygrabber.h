@@ -36,7 +36,12 @@ public:
         return numlockMask_;
     }
 
-    static std::vector<std::string> getPossibleKeySyms();
+    //! the names of the keysyms of all keycodes (without modifiers),
+    //! sorted and without duplicates. The list is computed once and
+    //! cached until the keyboard mapping changes.
+    const std::vector<std::string>& getPossibleKeySyms();
+    //! drop the cached data about the keyboard mapping
+    void keyboardMappingChanged();
 
 private:
     void changeGrabbedState(const KeyCombo& keyCombo, bool grabbed);
@@ -49,6 +54,8 @@ private:
     // for each key code, whenever we see a key down event, remember
     // the modifier mask, such that we can re-use it for the key up event.
     std::map<unsigned int, unsigned int> keycode2modifierMask_;
+    bool possibleKeySymsValid_ = false;
+    std::vector<std::string> possibleKeySyms_;
     int keyComboCount(const KeyCombo& x11KeyCombo);
     void setKeyComboCount(const KeyCombo& x11KeyCombo, int newCount);
     XConnection& X_;
@@ -4,7 +4,16 @@
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/cursorfont.h>
+#include <X11/extensions/Xrandr.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
@@ -29,6 +38,7 @@
 #include "settings.h"
 #include "tag.h"
 #include "tagmanager.h"
+#include "timerqueue.h"
 #include "utils.h"
 #include "watchers.h"
 #include "xconnection.h"
@@ -59,6 +69,10 @@ XMainLoop::XMainLoop(XConnection& X, Root* root)
     , aboutToQuit_(false)
     , handlerTable_()
 {
+    callHandler_ = [this](IpcServer::CallId id, vector<string> call,
+                          IpcServer::CallResult& result) {
+        callCommand(id, std::move(call), result);
+    };
     handlerTable_[ ButtonPress       ] = EH(&XMainLoop::buttonpress);
     handlerTable_[ ButtonRelease     ] = EH(&XMainLoop::buttonrelease);
     handlerTable_[ ClientMessage     ] = EH(&XMainLoop::clientmessage);
@@ -71,6 +85,7 @@ XMainLoop::XMainLoop(XConnection& X, Root* root)
     handlerTable_[ FocusIn           ] = EH(&XMainLoop::focusin);
     handlerTable_[ KeyPress          ] = EH(&XMainLoop::keypressOrRelease);
     handlerTable_[ KeyRelease        ] = EH(&XMainLoop::keypressOrRelease);
+    handlerTable_[ LeaveNotify       ] = EH(&XMainLoop::leavenotify);
     handlerTable_[ MapNotify         ] = EH(&XMainLoop::mapnotify);
     handlerTable_[ MapRequest        ] = EH(&XMainLoop::maprequest);
     handlerTable_[ MappingNotify     ] = EH(&XMainLoop::mappingnotify);
@@ -102,6 +117,16 @@ XMainLoop::XMainLoop(XConnection& X, Root* root)
     } else {
         HSDebug("XFixes extension missing, so I can not react to compositors coming or leaving\n");
     }
+    // get events if monitors are connected, disconnected, or changed
+    if (XRRQueryExtension(X_.display(), &xrandrEventBase_, &xrandrErrorBase_)) {
+        XRRSelectInput(X_.display(), X_.root(),
+                       RRScreenChangeNotifyMask
+                       | RRCrtcChangeNotifyMask
+                       | RROutputChangeNotifyMask);
+    } else {
+        xrandrEventBase_ = LASTEvent;
+        HSDebug("XRandR extension missing, so monitor changes are only noticed via the root window size\n");
+    }
 }
 
 //! scan for windows and add them to the list of managed clients
@@ -115,13 +140,12 @@ void XMainLoop::scanExistingClients() {
         return originalClients.end()
             != std::find(originalClients.begin(), originalClients.end(), win);
     };
-    auto findTagForWindow = [this](Window win) -> function<void(ClientChanges&)> {
+    auto tagFromDesktop = [this](long idx) -> function<void(ClientChanges&)> {
             if (!root_->globals.importTagsFromEwmh) {
                 // do nothing, if import is disabled
                 return [] (ClientChanges&) {};
             }
-            return [this,win] (ClientChanges& changes) {
-                long idx = this->root_->ewmh_.windowGetInitialDesktop(win);
+            return [this,idx] (ClientChanges& changes) {
                 if (idx < 0) {
                     return;
                 }
@@ -131,9 +155,20 @@ void XMainLoop::scanExistingClients() {
                 }
             };
     };
-    for (auto win : X_.queryTree(X_.root())) {
-        if (!XGetWindowAttributes(X_.display(), win, &wa) || wa.override_redirect)
-        {
+    auto findTagForWindow = [this,&tagFromDesktop](Window win) {
+        return tagFromDesktop(root_->ewmh_.windowGetInitialDesktop(win));
+    };
+    // request the attributes and properties of all windows at once
+    // instead of one round-trip per window and request
+    vector<Window> windows = X_.queryTree(X_.root());
+    auto states = X_.getWindowStateBatch(windows);
+    auto windowTypes = X_.getWindowProperty32Batch(
+                windows, root_->ewmh_.netatom(NetWmWindowType), XA_ATOM);
+    auto desktops = X_.getWindowProperty32Batch(
+                windows, root_->ewmh_.netatom(NetWmDesktop), XA_CARDINAL);
+    for (size_t i = 0; i < windows.size(); i++) {
+        Window win = windows[i];
+        if (!states[i] || states[i]->overrideRedirect) {
             continue;
         }
         // only manage mapped windows.. no strange wins like:
@@ -144,21 +179,29 @@ void XMainLoop::scanExistingClients() {
         if (root_->ewmh_.isOwnWindow(win)) {
             continue;
         }
-        if (root_->ewmh_.getWindowType(win) == NetWmWindowTypeDesktop)
+        int windowType = -1;
+        if (windowTypes[i]) {
+            windowType = root_->ewmh_.windowTypeFromAtoms(windowTypes[i].value());
+        }
+        if (windowType == NetWmWindowTypeDesktop)
         {
             DesktopWindow::registerDesktop(win);
             root_->monitors->restack();
             XMapWindow(X_.display(), win);
         }
-        else if (root_->ewmh_.getWindowType(win) == NetWmWindowTypeDock)
+        else if (windowType == NetWmWindowTypeDock)
         {
             root_->panels->registerPanel(win);
             XSelectInput(X_.display(), win, PropertyChangeMask);
             XMapWindow(X_.display(), win);
         }
-        else if (wa.map_state == IsViewable
+        else if (states[i]->viewable
             || isInOriginalClients(win)) {
-            Client* c = clientmanager->manage_client(win, true, false, findTagForWindow(win));
+            long desktop = -1;
+            if (desktops[i] && !desktops[i]->empty()) {
+                desktop = static_cast<long>(desktops[i]->front());
+            }
+            Client* c = clientmanager->manage_client(win, true, false, tagFromDesktop(desktop));
             if (root_->monitors->byTag(c->tag())) {
                 XMapWindow(X_.display(), win);
             }
@@ -178,25 +221,109 @@ void XMainLoop::scanExistingClients() {
         clientmanager->manage_client(win, true, false, findTagForWindow(win));
     }
     root_->monitors->restack();
+    HSDebug("Scanned %zu existing windows\n", windows.size());
 }
 
 
+//! the pipe to which the signal handler writes the received signals:
+//! 0: for reading in the main loop, 1: for writing in the signal handler
+static int g_signalPipe[2] = { -1, -1 };
+
+void XMainLoop::installSignalHandlers()
+{
+    if (pipe(g_signalPipe) == -1) {
+        perror("herbstluftwm: can not create pipe for signals");
+        exit(EXIT_FAILURE);
+    }
+    for (int fd : g_signalPipe) {
+        // the signal handler must never block and
+        // child processes must not inherit the pipe
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    for (int signum : { SIGCHLD, SIGINT, SIGQUIT, SIGTERM }) {
+        struct sigaction act = {};
+        act.sa_handler = XMainLoop::handleSignal;
+        sigemptyset(&act.sa_mask);
+        // SA_NOCLDSTOP: we don't receive anything on stopped children
+        act.sa_flags = SA_NOCLDSTOP | SA_RESTART;
+        sigaction(signum, &act, nullptr);
+    }
+}
+
+void XMainLoop::handleSignal(int signal)
+{
+    // only async-signal-safe functions may be used here
+    int savedErrno = errno;
+    unsigned char signum = static_cast<unsigned char>(signal);
+    // if the pipe is full, then the main loop is woken up anyway
+    ssize_t written = write(g_signalPipe[1], &signum, 1);
+    (void) written;
+    errno = savedErrno;
+}
+
+void XMainLoop::readSignalPipe()
+{
+    unsigned char signum;
+    while (read(g_signalPipe[0], &signum, 1) == 1) {
+        if (signum == SIGCHLD) {
+            // the zombies are collected after each wakeup anyway
+            continue;
+        }
+        HSDebug("Interrupted by signal %d\n", signum);
+        quit();
+    }
+}
+
 void XMainLoop::run() {
     XEvent event;
-    int x11_fd;
-    fd_set in_fds;
-    x11_fd = ConnectionNumber(X_.display());
+    struct pollfd fds[2];
+    fds[0].fd = ConnectionNumber(X_.display());
+    fds[1].fd = g_signalPipe[0];
     while (!aboutToQuit_) {
-        // before making the process hang in the `select` call,
+        // before making the process hang in the `poll` call,
         // first collect all zombies:
         collectZombies();
-        // set the the `select` sets:
-        FD_ZERO(&in_fds);
-        FD_SET(x11_fd, &in_fds);
-        // wait for an event or a signal
-        select(x11_fd + 1, &in_fds, nullptr, nullptr, nullptr);
-        // if `select` was interrupted by a signal, then it was maybe SIGCHLD
-        collectZombies();
+        if (root_->timerQueue_->runDue()) {
+            root_->watchers->scanForChanges();
+        }
+        // the client lists are written once for all changes
+        // of the last event batch, ipc call, or timer
+        root_->ewmh_.flushClientLists();
+        // wait for an event or a signal. If there are pending ipc calls or
+        // if running the last call already queued some events, then
+        // only check for new events but do not wait. If there are
+        // timers, then only wait until the next one is due.
+        bool dontWait = root_->ipcServer_.hasPendingCalls()
+                        || !deferredCalls_.empty()
+                        || XPending(X_.display()) > 0;
+        auto untilNextTimer = root_->timerQueue_->timeUntilNext();
+        int timeoutMs = -1; // wait forever
+        if (dontWait) {
+            timeoutMs = 0;
+        } else if (untilNextTimer.has_value()) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          untilNextTimer.value());
+            // round up such that the timer is due after the timeout
+            if (ms < untilNextTimer.value()) {
+                ms += std::chrono::milliseconds(1);
+            }
+            timeoutMs = static_cast<int>(std::min<long long>(ms.count(), INT_MAX));
+        }
+        for (auto& pfd : fds) {
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+        }
+        // a signal arriving before or during the `poll` call is not lost,
+        // because the signal handler has written it into the pipe
+        poll(fds, 2, timeoutMs);
+        if (fds[1].revents & POLLIN) {
+            readSignalPipe();
+        }
+        if (collectZombies()) {
+            // e.g. autostart.running changed without any X event
+            root_->watchers->scanForChanges();
+        }
         if (aboutToQuit_) {
             break;
         }
@@ -211,25 +338,70 @@ void XMainLoop::run() {
             } else {
                 if (event.type == xfixesEventBase_ + XFixesSelectionNotify) {
                     selectionnotify((XFixesSelectionNotifyEvent*)&event);
+                } else if (event.type == xrandrEventBase_ + RRScreenChangeNotify
+                           || event.type == xrandrEventBase_ + RRNotify) {
+                    xrandrnotify(&event);
                 }
             }
             root_->watchers->scanForChanges();
             XSync(X_.display(), False);
         }
+        // run one ipc call after each batch of events, such that
+        // many ipc calls do not delay the handling of input. The calls
+        // of slow commands only run if there are no other calls, such
+        // that they do not delay the replies to other clients either.
+        if (root_->ipcServer_.runPendingCall(callHandler_)
+            || runDeferredCall())
+        {
+            root_->watchers->scanForChanges();
+        }
     }
 }
 
-void XMainLoop::collectZombies()
+//! reap all exited children and return whether there were any
+bool XMainLoop::collectZombies()
 {
     int childInfo;
     pid_t childPid;
+    bool collectedAny = false;
     while (true) {
         childPid = waitpid(-1, &childInfo, WNOHANG);
         if (childPid <= 0) {
             break;
         }
+        collectedAny = true;
         childExited.emit(make_pair(childPid, WEXITSTATUS(childInfo)));
     }
+    return collectedAny;
+}
+
+/**
+ * @brief The title of the given client changed, so read it immediately
+ * or, if it was read less than title_update_interval ago, once this
+ * interval has passed.
+ */
+void XMainLoop::scheduleTitleUpdate(Client* client)
+{
+    auto interval = std::chrono::milliseconds(root_->settings->title_update_interval());
+    auto nextUpdate = client->lastTitleUpdate_ + interval;
+    auto now = TimerQueue::Clock::now();
+    if (now >= nextUpdate) {
+        client->update_title();
+        return;
+    }
+    // all further changes until then are covered by this update
+    Window window = client->window_;
+    if (!pendingTitleUpdates_.insert(window).second) {
+        return;
+    }
+    root_->timerQueue_->add(nextUpdate - now, [this, window]() {
+        pendingTitleUpdates_.erase(window);
+        // the client might have been unmanaged meanwhile
+        Client* current = root_->clients->client(window);
+        if (current) {
+            current->update_title();
+        }
+    });
 }
 
 void XMainLoop::quit() {
@@ -318,8 +490,7 @@ void XMainLoop::createnotify(XCreateWindowEvent* event) {
     // printf("name is: CreateNotify\n");
     if (root_->ipcServer_.isConnectable(event->window)) {
         root_->ipcServer_.addConnection(event->window);
-        root_->ipcServer_.handleConnection(event->window,
-                                           XMainLoop::callCommand);
+        root_->ipcServer_.queueConnection(event->window, callHandler_);
     }
 }
 
@@ -413,14 +584,9 @@ void XMainLoop::clientmessage(XClientMessageEvent* event) {
 
 void XMainLoop::configurenotify(XConfigureEvent* event) {
     if (event->window == X_.root()) {
+        XRRUpdateConfiguration((XEvent*)event);
         root_->panels->rootWindowChanged(event->width, event->height);
-        if (root_->settings->auto_detect_monitors()) {
-            Input input = Input("detect_monitors");
-            std::ostringstream void_output;
-            // discard output, but forward errors to std:cerr
-            OutputChannels channels("", void_output, std::cerr);
-            root_->monitors->detectMonitorsCommand(input, channels);
-        }
+        scheduleMonitorDetection();
     } else {
         Rectangle geometry = { event->x, event->y, event->width, event->height };
         root_->panels->geometryChanged(event->window, geometry);
@@ -428,6 +594,39 @@ void XMainLoop::configurenotify(XConfigureEvent* event) {
     // HSDebug("name is: ConfigureNotify\n");
 }
 
+void XMainLoop::xrandrnotify(XEvent* event) {
+    if (event->type == xrandrEventBase_ + RRScreenChangeNotify) {
+        XRRUpdateConfiguration(event);
+    }
+    scheduleMonitorDetection();
+}
+
+/**
+ * @brief The monitor configuration changed. If auto_detect_monitors is
+ * set, then run detect_monitors once the burst of events that comes
+ * with (un)plugging or (un)docking is over.
+ */
+void XMainLoop::scheduleMonitorDetection()
+{
+    if (!root_->settings->auto_detect_monitors() || monitorDetectionPending_) {
+        return;
+    }
+    monitorDetectionPending_ = true;
+    // all further events within this delay are handled by the same detection
+    auto delay = std::chrono::milliseconds(root_->settings->monitor_detection_delay());
+    root_->timerQueue_->add(delay, [this]() {
+        monitorDetectionPending_ = false;
+        if (!root_->settings->auto_detect_monitors()) {
+            return;
+        }
+        Input input = Input("detect_monitors");
+        std::ostringstream void_output;
+        // discard output, but forward errors to std:cerr
+        OutputChannels channels("", void_output, std::cerr);
+        root_->monitors->detectMonitorsCommand(input, channels);
+    });
+}
+
 void XMainLoop::destroynotify(XUnmapEvent* event) {
     // try to unmanage it
     //HSDebug("name is: DestroyNotify for %lx\n", event->xdestroywindow.window);
@@ -438,6 +637,7 @@ void XMainLoop::destroynotify(XUnmapEvent* event) {
     } else {
         DesktopWindow::unregisterDesktop(event->window);
         root_->panels->unregisterPanel(event->window);
+        root_->ipcServer_.removeConnection(event->window);
     }
 }
 
@@ -455,6 +655,7 @@ void XMainLoop::enternotify(XCrossingEvent* ce) {
     Client* decorationClient = Decoration::toClient(ce->window);
     if (decorationClient) {
         decorationClient->dec->updateResizeAreaCursors();
+        decorationClient->dec->updateCursor(Point2D { ce->x, ce->y });
     }
     if (!root_->mouse->mouse_is_dragging()
         && root_->settings()->focus_follows_mouse()
@@ -488,6 +689,15 @@ void XMainLoop::enternotify(XCrossingEvent* ce) {
     duringEnterNotify_ = false;
 }
 
+void XMainLoop::leavenotify(XCrossingEvent* ce) {
+    // the cursor shape must not remain when the pointer
+    // moves from the decoration into the client window
+    Client* decorationClient = Decoration::toClient(ce->window);
+    if (decorationClient) {
+        decorationClient->dec->updateCursor({});
+    }
+}
+
 void XMainLoop::expose(XEvent* event) {
     //if (event->xexpose.count > 0) return;
     //Window ewin = event->xexpose.window;
@@ -543,12 +753,27 @@ void XMainLoop::mappingnotify(XMappingEvent* ev) {
     // regrab when keyboard map changes
     XRefreshKeyboardMapping(ev);
     if(ev->request == MappingKeyboard) {
+        root_->xKeyGrabber_->keyboardMappingChanged();
         root_->xKeyGrabber_->regrabAll();
         //TODO: mouse_regrab_all();
     }
 }
 
 void XMainLoop::motionnotify(XMotionEvent* event) {
+    Client* decorationClient = Decoration::toClient(event->window);
+    if (decorationClient && !root_->mouse->mouse_is_dragging()) {
+        // pointer motion on a decoration without resizeArea windows
+        while (XCheckTypedWindowEvent(X_.display(), event->window,
+                                      MotionNotify, (XEvent *)event)) {
+            ;
+        }
+        // motion within the client window propagates to the decoration,
+        // but it is not relevant for the cursor shape on the decoration
+        if (event->subwindow == None) {
+            decorationClient->dec->updateCursor(Point2D { event->x, event->y });
+        }
+        return;
+    }
     // get newest motion notification
     while (XCheckMaskEvent(X_.display(), ButtonMotionMask, (XEvent *)event)) {
         ;
@@ -645,8 +870,7 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
     Client* client = root_->clients->client(ev->window);
     if (ev->state == PropertyNewValue) {
         if (root_->ipcServer_.isConnectable(ev->window)) {
-            root_->ipcServer_.handleConnection(ev->window,
-                                               XMainLoop::callCommand);
+            root_->ipcServer_.queueConnection(ev->window, callHandler_);
         } else if (client != nullptr) {
             //char* atomname = XGetAtomName(X_.display(), ev->atom);
             //HSDebug("Property notify for client %s: atom %d \"%s\"\n",
@@ -661,14 +885,12 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
                 Rectangle geom = client->float_size_;
                 client->applysizehints(&geom.width, &geom.height, true);
                 client->float_size_ = geom;
-                Monitor* m = find_monitor_with_tag(client->tag());
-                if (m) {
-                    m->applyLayout();
-                }
+                root_->monitors->relayoutTag(client->tag());
             } else if (ev->atom == XA_WM_NAME ||
                        ev->atom == root_->ewmh_.netatom(NetWmName)) {
-                client->update_title();
-            } else if (ev->atom == XA_WM_CLASS && client) {
+                scheduleTitleUpdate(client);
+            } else if (ev->atom == XA_WM_CLASS) {
+                client->propertyChanged(ev->atom);
                 // according to the ICCCM specification, the WM_CLASS property may only
                 // be changed in the withdrawn state:
                 // https://www.x.org/releases/X11R7.6/doc/xorg-docs/specs/ICCCM/icccm.html#wm_class_property
@@ -676,10 +898,15 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
                 // As a workaround, we do it now:
                 auto stdio = OutputChannels::stdio();
                 root_->clients()->applyRules(client, stdio);
+            } else {
+                client->propertyChanged(ev->atom);
             }
         } else {
             root_->panels->propertyChanged(ev->window, ev->atom);
         }
+    } else if (ev->state == PropertyDelete && client != nullptr) {
+        // the cached properties are reset if they are deleted
+        client->propertyChanged(ev->atom);
     }
 }
 
@@ -754,22 +981,64 @@ void XMainLoop::setInputFocus(Client* newFocus)
     }
 }
 
-IpcServer::CallResult XMainLoop::callCommand(const vector<string>& call)
+/**
+ * @brief Handle an ipc call. The calls of slow commands are only put
+ * into the queue of deferred calls and answered later.
+ */
+void XMainLoop::callCommand(IpcServer::CallId id, vector<string> call,
+                            IpcServer::CallResult& result)
 {
-    // the call consists of the command and its arguments
-    std::ostringstream output;
-    std::ostringstream error;
-    string commandName = (call.empty()) ? "" : call[0];
-    auto input =
-        (call.empty())
-        ? Input("", call)
-        : Input(call[0], vector<string>(call.begin() + 1, call.end()));
-    IpcServer::CallResult result;
+    if (call.empty() || !Commands::replyIsDeferred(call.front())) {
+        runCommand(std::move(call), result);
+        return;
+    }
+    if (deferredCalls_.size() >= maxDeferredCalls_) {
+        // the result buffer is shared, so mark this call
+        // as pending only after running the other one
+        runDeferredCall();
+    }
+    deferredCalls_.push_back({ id, std::move(call) });
+    result.pending = true;
+}
+
+//! run the oldest deferred call and answer it, return if there was one
+bool XMainLoop::runDeferredCall()
+{
+    if (deferredCalls_.empty()) {
+        return false;
+    }
+    DeferredCall call = std::move(deferredCalls_.front());
+    deferredCalls_.pop_front();
+    if (!root_->ipcServer_.hasDeferredCall(call.id)) {
+        // like pending calls, the calls of destroyed clients are dropped
+        return true;
+    }
+    IpcServer::CallResult& result = root_->ipcServer_.emptyResult();
+    runCommand(std::move(call.arguments), result);
+    root_->ipcServer_.completeCall(call.id, result);
+    return true;
+}
+
+void XMainLoop::runCommand(vector<string> call, IpcServer::CallResult& result)
+{
+    // the call consists of the command and its arguments. The output is
+    // written directly to the (reused) strings of the result
+    StringOutputBuffer outputBuffer(result.output);
+    StringOutputBuffer errorBuffer(result.error);
+    std::ostream output(&outputBuffer);
+    std::ostream error(&errorBuffer);
+    string commandName;
+    if (!call.empty()) {
+        commandName = std::move(call.front());
+        call.erase(call.begin());
+    }
+    // the arguments are moved into the input and are
+    // not copied when the input is passed around
+    Input input(commandName, std::move(call));
     OutputChannels channels(commandName, output, error);
     result.exitCode = Commands::call(input, channels);
-    result.output = output.str();
-    result.error = error.str();
-    return result;
+    // the caller may inspect the client lists right after the reply
+    Ewmh::get().flushClientLists();
 }
 
 void XMainLoop::draggedClientChanges(Client* draggedClient)
@@ -4,6 +4,8 @@
 #include <X11/Xlib.h>
 #include <X11/extensions/Xfixes.h>
 #include <unistd.h> // for pid_t
+#include <deque>
+#include <set>
 
 #include "ipc-server.h"
 #include "signal.h"
@@ -20,6 +22,11 @@ public:
     void run();
     //! quit the main loop as soon as possible
     void quit();
+    /** install the handlers for SIGCHLD, SIGINT, SIGQUIT, and SIGTERM.
+     * They only write the signal number into a pipe that is watched by
+     * the main loop, so a signal arriving at any time wakes it up.
+     */
+    static void installSignalHandlers();
     using EventHandler = void (XMainLoop::*)(XEvent*);
     //! a child process exited with the given status
     Signal_<std::pair<pid_t, int>> childExited;
@@ -33,8 +40,18 @@ private:
     EventHandler handlerTable_[LASTEvent];
     int xfixesEventBase_ = LASTEvent;
     int xfixesErrorBase_ = 0;
+    int xrandrEventBase_ = LASTEvent;
+    int xrandrErrorBase_ = 0;
 
-    void collectZombies();
+    bool collectZombies();
+    static void handleSignal(int signal);
+    void readSignalPipe();
+    void scheduleTitleUpdate(Client* client);
+    //! the windows whose title is read again by a timer
+    std::set<Window> pendingTitleUpdates_;
+    void scheduleMonitorDetection();
+    //! whether a timer for the automatic monitor detection is running
+    bool monitorDetectionPending_ = false;
     // event handlers
     void buttonpress(XButtonEvent* be);
     void buttonrelease(XButtonEvent* event);
@@ -44,6 +61,7 @@ private:
     void configurenotify(XConfigureEvent* event);
     void destroynotify(XUnmapEvent* event);
     void enternotify(XCrossingEvent* ce);
+    void leavenotify(XCrossingEvent* ce);
     void expose(XEvent* event);
     void focusin(XFocusChangeEvent* event);
     void keypressOrRelease(XKeyEvent* event);
@@ -53,6 +71,7 @@ private:
     void maprequest(XMapRequestEvent* mapreq);
     void selectionclear(XSelectionClearEvent* event);
     void selectionnotify(XFixesSelectionNotifyEvent* event);
+    void xrandrnotify(XEvent* event);
     void propertynotify(XPropertyEvent* event);
     void unmapnotify(XUnmapEvent* event);
 
@@ -63,7 +82,22 @@ private:
     bool duringEnterNotify_ = false; //! whether we are in enternotify()
     bool duringFocusIn_ = false; //! whether we are in focusin()
 
-    static IpcServer::CallResult callCommand(const std::vector<std::string>& call);
+    void callCommand(IpcServer::CallId id, std::vector<std::string> call,
+                     IpcServer::CallResult& result);
+    static void runCommand(std::vector<std::string> call, IpcServer::CallResult& result);
+    //! callCommand() as a handler for the IpcServer
+    IpcServer::CallHandler callHandler_;
+    bool runDeferredCall();
+    class DeferredCall {
+    public:
+        IpcServer::CallId id;
+        std::vector<std::string> arguments;
+    };
+    //! the ipc calls of slow commands that are run once there
+    //is nothing else to do, in the order in which they arrived
+    std::deque<DeferredCall> deferredCalls_;
+    //! the maximum length of deferredCalls_
+    static const size_t maxDeferredCalls_ = 16;
 
 
     // handlers of events from hlwm
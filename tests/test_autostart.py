@@ -135,6 +135,17 @@ def test_autostart_last_status(hlwm, tmpdir):
         assert hlwm.attr.autostart.last_status() == status
 
 
+def test_autostart_exit_without_x_events(hlwm, hc_idle, tmpdir):
+    hlwm.call('watch autostart.running')
+    run_autostart(hlwm, tmpdir, 'sleep 0.5\n', wait=False)
+
+    # the exit of the autostart is noticed even though
+    # nothing else happens meanwhile
+    expected = ['attribute_changed', 'autostart.running', 'true', 'false']
+    while hc_idle.read_hook() != expected:
+        pass
+
+
 def process_status(pid):
     ps_cmd = ['ps', '-p', str(pid), '-o', 'state']
     proc = subprocess.run(ps_cmd,
@@ -1,7 +1,9 @@
 import pytest
 import random
+import time
 from conftest import PROCESS_SHUTDOWN_TIME
 from herbstluftwm.types import Rectangle
+from Xlib import Xatom
 
 
 def test_client_lives_longer_than_hlwm(hlwm):
@@ -251,6 +253,65 @@ def test_client_wm_class_none(hlwm, x11):
     assert hlwm.get_attr('clients.{}.class'.format(winid)) == ''
 
 
+def test_title_update_interval(hlwm, x11):
+    hlwm.attr.settings.title_update_interval = 1000
+    handle, winid = x11.create_client()
+
+    for title in ['first', 'second', 'final']:
+        x11.set_window_title(handle, title)
+    x11.sync_with_hlwm()
+    # the client was managed less than a second ago
+    assert hlwm.get_attr(f'clients.{winid}.title') == 'Some Window'
+
+    time.sleep(1.2)
+    x11.sync_with_hlwm()
+    assert hlwm.get_attr(f'clients.{winid}.title') == 'final'
+
+
+def test_client_window_properties_are_updated(hlwm, x11):
+    handle, winid = x11.create_client(wm_class=('inst', 'cls'),
+                                      window_type='_NET_WM_WINDOW_TYPE_DIALOG',
+                                      pid=1234)
+    assert hlwm.get_attr(f'clients.{winid}.window_type') == '_NET_WM_WINDOW_TYPE_DIALOG'
+    assert hlwm.get_attr(f'clients.{winid}.window_role') == ''
+
+    x11.set_property_textlist('WM_WINDOW_ROLE', ['myrole'], window=handle)
+    x11.set_property_cardinal('_NET_WM_PID', [4321], window=handle)
+    handle.change_property(x11.display.intern_atom('_NET_WM_WINDOW_TYPE'),
+                           Xatom.ATOM, 32,
+                           [x11.display.intern_atom('_NET_WM_WINDOW_TYPE_UTILITY')])
+    handle.set_wm_class('newinst', 'newcls')
+    x11.sync_with_hlwm()
+
+    assert hlwm.get_attr(f'clients.{winid}.window_role') == 'myrole'
+    assert hlwm.get_attr(f'clients.{winid}.pid') == '4321'
+    assert hlwm.get_attr(f'clients.{winid}.window_type') == '_NET_WM_WINDOW_TYPE_UTILITY'
+    assert hlwm.get_attr(f'clients.{winid}.instance') == 'newinst'
+    assert hlwm.get_attr(f'clients.{winid}.class') == 'newcls'
+
+    # deleting the properties resets the attributes
+    for prop in ['WM_WINDOW_ROLE', '_NET_WM_PID', '_NET_WM_WINDOW_TYPE']:
+        handle.delete_property(x11.display.intern_atom(prop))
+    x11.sync_with_hlwm()
+
+    assert hlwm.get_attr(f'clients.{winid}.window_role') == ''
+    assert hlwm.get_attr(f'clients.{winid}.pid') == '-1'
+    assert hlwm.get_attr(f'clients.{winid}.window_type') == ''
+
+
+@pytest.mark.parametrize("net_wm_name", [None, 'Net Title'])
+def test_client_title_on_manage(hlwm, x11, net_wm_name):
+    def set_net_wm_name(w):
+        if net_wm_name is not None:
+            x11.set_property_textlist('_NET_WM_NAME', [net_wm_name], window=w)
+
+    _, winid = x11.create_client(pre_map=set_net_wm_name)
+
+    # the WM_NAME set by create_client() is only used as a fallback
+    expected = net_wm_name if net_wm_name is not None else 'Some Window'
+    assert hlwm.get_attr(f'clients.{winid}.title') == expected
+
+
 def test_bring_from_different_tag(hlwm, x11):
     _, bonnie = x11.create_client()
     hlwm.call('true')
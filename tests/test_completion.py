@@ -291,3 +291,31 @@ def test_optional_args_in_argparse_dont_pile_up(hlwm):
     for cmd in commands:
         res = hlwm.complete(cmd, evaluate_escapes=True)
         assert len([v for v in res if v == '0']) == 1
+
+
+def test_completion_of_prefix_is_filtered_full_completion(hlwm):
+    winids = hlwm.create_clients(3)
+    # for each completion domain: the full completion and a needle
+    domains = [
+        ([], 's'),
+        (['apply_rules'], '0x'),
+        (['apply_rules'], winids[0][0:-1]),
+        (['apply_rules'], 'focus'),
+        (['get_attr'], 'tags.focus.c'),
+        (['get_attr'], 'clients.'),
+        (['get_attr'], 'clients.' + winids[1][0:4]),
+        (['get_attr'], 'xyz'),
+        (['set'], 'frame_b'),
+    ]
+    for command, needle in domains:
+        everything = hlwm.complete(command, partial=True)
+        expected = [c for c in everything if c.startswith(needle)]
+        if '.' in needle:
+            # the completion only lists the next level of the object tree
+            objpath = needle[0:needle.rindex('.') + 1]
+            expected = hlwm.complete(command + [objpath], partial=True,
+                                     position=len(command))
+            expected = [c for c in expected if c.startswith(needle)]
+        assert hlwm.complete(command + [needle], partial=True,
+                             position=len(command)) == expected
+    assert 'focus ' not in hlwm.complete(['apply_rules'], partial=True)
@@ -523,3 +523,44 @@ def test_decoration_title_align(hlwm, x11, client_count):
     x_diff = hlwm.attr.clients.focus.decoration_geometry().width / client_count / 3
     assert align_to_title_pos['left'].x + x_diff < align_to_title_pos['center'].x
     assert align_to_title_pos['center'].x + x_diff < align_to_title_pos['right'].x
+
+
+def test_decoration_subwindows_created_when_shown(hlwm, x11):
+    hlwm.call('add othertag')
+    hlwm.call('rule tag=othertag')
+    handle, _ = x11.create_client()
+    decoration = handle.query_tree().parent
+
+    def decoration_children_count():
+        x11.sync_with_hlwm()
+        return len(decoration.query_tree().children)
+
+    # only the client window and the background window
+    assert decoration_children_count() == 2
+
+    hlwm.call('use othertag')
+
+    # additionally the 12 windows for the resize areas
+    assert decoration_children_count() == 2 + 12
+
+
+def test_decoration_resize_windows_setting(hlwm, x11):
+    handle, _ = x11.create_client()
+    decoration = handle.query_tree().parent
+
+    def decoration_children_count():
+        x11.sync_with_hlwm()
+        return len(decoration.query_tree().children)
+
+    assert decoration_children_count() == 2 + 12
+
+    hlwm.attr.settings.decoration_resize_windows = False
+    # only the client window and the background window
+    assert decoration_children_count() == 2
+    # resizing the client works without the resize area windows
+    hlwm.call('set_attr clients.focus.floating on')
+    hlwm.call('set_attr clients.focus.floating_geometry 300x200+40+50')
+    assert decoration_children_count() == 2
+
+    hlwm.attr.settings.decoration_resize_windows = True
+    assert decoration_children_count() == 2 + 12
@@ -350,6 +350,15 @@ def test_ewmh_focused_client_never_urgent(hlwm, hc_idle, x11, focused):
     assert (['urgent', 'on', winid] in hc_idle.hooks()) == (not focused)
 
 
+def test_ewmh_wm_state_invalid_action_is_ignored(hlwm, x11):
+    winHandle, winid = x11.create_client()
+
+    x11.ewmh.setWmState(winHandle, 3, '_NET_WM_STATE_FULLSCREEN')
+    x11.sync_with_hlwm()
+
+    assert hlwm.get_attr(f'clients.{winid}.fullscreen') == 'false'
+
+
 def test_ewmh_make_client_urgent_no_focus_stealing(hlwm, hc_idle, x11):
     hlwm.call('set focus_stealing_prevention on')
     hlwm.call('add otherTag')
@@ -462,6 +471,23 @@ def test_net_supported(hlwm, x11):
         assert atom in supported_actions
 
 
+def test_net_client_list_order(hlwm, x11):
+    windows = [x11.create_client()[0] for _ in range(5)]
+    assert x11.get_property('_NET_CLIENT_LIST') == [w.id for w in windows]
+
+    # remove two windows and add a new one in the same event batch
+    for removed in [windows[1], windows[3]]:
+        removed.destroy()
+        x11.windows.discard(removed)
+    new_window = x11.create_client(sync_hlwm=False)[0]
+    x11.sync_with_hlwm()
+
+    expected = [windows[i].id for i in [0, 2, 4]] + [new_window.id]
+    assert x11.get_property('_NET_CLIENT_LIST') == expected
+    stacking = x11.get_property('_NET_CLIENT_LIST_STACKING')
+    assert sorted(stacking) == sorted(expected)
+
+
 def test_close_window(hlwm, x11):
     # we use hlwm's create_client and not x11's because
     # it's easier to wait for the process to shut down
@@ -248,6 +248,22 @@ def test_focus_directional_between_identical_geometries(hlwm, forward, backward)
     assert sorted(traversed) == sorted(clients)
 
 
+def test_directional_focus_after_geometry_change(hlwm):
+    hlwm.attr.tags.focus.floating = True
+    hlwm.attr.monitors.focus.geometry = Rectangle(x=0, y=0, width=800, height=600)
+    left, _ = hlwm.create_client(position=(0, 0))
+    right, _ = hlwm.create_client(position=(400, 0))
+    hlwm.call(['jumpto', right])
+    hlwm.call_xfail('focus right').expect_stderr('No neighbour found')
+
+    # move 'left' to the right of 'right' such that
+    # 'right' gets a neighbour on its right
+    hlwm.attr.clients[left].floating_geometry = '100x100+600+0'
+
+    hlwm.call('focus right')
+    assert hlwm.attr.clients.focus.winid() == left
+
+
 @pytest.mark.parametrize('direction', ['up', 'down', 'left', 'right'])
 def test_resize_shrink_client(hlwm, direction):
     hlwm.attr.settings.snap_gap = 5
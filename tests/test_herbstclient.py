@@ -443,3 +443,54 @@ def test_command_tokenization_in_x11_property(hlwm):
     ]
     for cmd, output in cmd2output:
         assert hlwm.call(cmd).stdout == output
+
+
+@pytest.mark.parametrize('count', [5, 100])
+def test_concurrent_calls_get_their_own_reply(hlwm, count):
+    """
+    Many herbstclient processes at once: the calls are queued on the
+    server side (exceeding the queue length for the larger count) and
+    every client still gets the reply to its own call.
+    """
+    procs = []
+    for i in range(0, count):
+        procs.append(subprocess.Popen([HC_PATH, 'echo', f'call{i}'],
+                                      stdout=subprocess.PIPE,
+                                      stderr=subprocess.PIPE,
+                                      universal_newlines=True))
+    for i, proc in enumerate(procs):
+        stdout, stderr = proc.communicate(timeout=PROCESS_SHUTDOWN_TIME)
+        assert (stdout, stderr) == (f'call{i}\n', '')
+        assert proc.returncode == 0
+
+
+def test_deferred_calls_get_their_own_reply(hlwm):
+    """
+    The calls of slow commands like 'load' and 'detect_monitors' are
+    answered later than the others, but every client still gets the
+    reply to its own call.
+    """
+    layout = hlwm.call('dump').stdout
+    monitors = hlwm.call('detect_monitors --list').stdout
+    calls = []
+    for i in range(0, 30):
+        if i % 3 == 0:
+            calls.append((['load', layout], ('', ''), 0))
+        elif i % 3 == 1:
+            calls.append((['detect_monitors', '--list'], (monitors, ''), 0))
+        else:
+            calls.append((['echo', f'call{i}'], (f'call{i}\n', ''), 0))
+    calls.append((['load', '(invalid'], None, 3))
+    procs = []
+    for args, _, _ in calls:
+        procs.append(subprocess.Popen([HC_PATH] + args,
+                                      stdout=subprocess.PIPE,
+                                      stderr=subprocess.PIPE,
+                                      universal_newlines=True))
+    for (args, output, returncode), proc in zip(calls, procs):
+        stdout, stderr = proc.communicate(timeout=PROCESS_SHUTDOWN_TIME)
+        if output is not None:
+            assert (stdout, stderr) == output
+        else:
+            assert stderr != ''
+        assert proc.returncode == returncode
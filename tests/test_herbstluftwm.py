@@ -41,6 +41,23 @@ def test_wmexec_to_self(hlwm, hlwm_process, with_client, explicit_arg):
         assert winid in hlwm.list_children('clients')
 
 
+def test_wmexec_restores_clients_and_their_tags(hlwm, hlwm_process):
+    hlwm.call('add otherTag')
+    winids = hlwm.create_clients(3)
+    hlwm.call(['move', 'otherTag'])  # move the focused client
+    moved = hlwm.get_attr('clients.focus.winid')
+    expected_tags = {w: ('otherTag' if w == moved else 'default') for w in winids}
+
+    p = hlwm.unchecked_call(['wmexec', hlwm_process.bin_path, '--verbose'],
+                            read_hlwm_output=False)
+    assert p.returncode == 0
+    hlwm_process.read_and_echo_output(
+        until_stderr='startup: scanning the existing windows took')
+
+    for winid, tag in expected_tags.items():
+        assert hlwm.get_attr(f'clients.{winid}.tag') == tag
+
+
 @pytest.mark.parametrize("args,errormsg", [
     (['nonexistent'], 'No such file or directory'),
     (['/', 'dummy'], 'Permission denied'),
@@ -189,6 +189,18 @@ def test_complete_keybind_offers_additional_mods_without_duplication(hlwm):
     }
 
 
+@pytest.mark.parametrize('prefix', ['', 'Mod1+'])
+def test_complete_keybind_keysyms_by_prefix(hlwm, prefix):
+    complete = hlwm.complete(['keybind', prefix], partial=True, position=1)
+    keysyms = [c for c in complete if c.endswith(' ')]
+    # every keysym is offered only once
+    assert len(keysyms) == len(set(keysyms))
+    for needle in [prefix + 'R', prefix + 'Ret', prefix + 'x']:
+        expected = [c for c in complete if c.startswith(needle)]
+        assert hlwm.complete(['keybind', needle], partial=True, position=1) \
+            == expected
+
+
 def test_complete_keybind_validates_all_tokens(hlwm):
     # Note: This might seem like a stupid test, but previous implementations
     # ignored the invalid first modifier.
@@ -1,3 +1,4 @@
+import json
 import pytest
 import re
 
@@ -172,6 +173,18 @@ def test_sprintf_invalid_format(hlwm):
     assert call.returncode != 0
 
 
+def test_sprintf_same_format_repeatedly(hlwm):
+    for name in ['foo', 'bar']:
+        hlwm.attr.tags.focus.name = name
+        call = hlwm.call('sprintf X "[%s|%c]" tags.focus.name const echo X')
+        assert call.stdout == f'[{name}|const]\n'
+
+    # an invalid format string fails on every call
+    for _ in range(2):
+        hlwm.call_xfail('sprintf X %Z echo X') \
+            .expect_stderr('invalid format type %Z at position 1')
+
+
 def test_sprintf_completion_1_placeholder(hlwm):
     assert hlwm.complete('sprintf T %s', partial=True) \
         == sorted(hlwm.complete('get_attr', partial=True))
@@ -335,6 +348,88 @@ def test_remove_attr_user_attribute(hlwm):
     hlwm.call(['new_attr', 'string', path])  # and is free again
 
 
+def test_get_attrs_multiple_paths(hlwm):
+    hlwm.call('new_attr string my_str')
+    hlwm.attr.my_str = 'a\tb\\c\nd'
+
+    output = hlwm.call('get_attrs tags.focus.name my_str monitors.count').stdout
+
+    assert output.splitlines() == [
+        'tags.focus.name\tdefault',
+        'my_str\ta\\tb\\\\c\\nd',
+        'monitors.count\t1',
+    ]
+
+
+def test_get_attrs_object(hlwm):
+    output = hlwm.call('get_attrs settings.').stdout.splitlines()
+
+    expected = hlwm.call('attr settings.').stdout
+    assert len(output) == int(re.search(r'([0-9]+) attributes', expected).group(1))
+    assert 'settings.frame_gap\t' + hlwm.get_attr('settings.frame_gap') in output
+
+
+def test_get_attrs_invalid_path(hlwm):
+    hlwm.call_xfail('get_attrs tags.focus.name tags.foo') \
+        .expect_stderr('has no attribute "foo"')
+    hlwm.call_xfail('get_attrs tags.focus.name clients.foo.') \
+        .expect_stderr('No such object clients.foo.')
+    assert hlwm.call_xfail('get_attrs tags.focus.name tags.foo').stdout == ''
+
+
+def test_dump_objects(hlwm):
+    hlwm.call('add othertag')
+    hlwm.call(['new_attr', 'string', 'tags.my_str', '"quoted"\\\tstring'])
+
+    dump = json.loads(hlwm.call('dump_objects tags').stdout)
+
+    assert dump['attributes']['my_str'] == {
+        'type': 'string',
+        'writable': True,
+        'value': '"quoted"\\\tstring',
+    }
+    assert dump['attributes']['count']['type'] == 'uint'
+    assert dump['attributes']['count']['writable'] is False
+    assert sorted(dump['children'].keys()) == ['0', '1', 'by-name', 'focus']
+    othertag = dump['children']['by-name']['children']['othertag']
+    assert othertag['attributes']['name']['value'] == 'othertag'
+    assert dump['children']['focus']['attributes']['name']['value'] == 'default'
+
+
+def test_dump_objects_root(hlwm):
+    dump = json.loads(hlwm.call('dump_objects').stdout)
+
+    for child in ['clients', 'monitors', 'settings', 'tags', 'theme']:
+        assert child in dump['children']
+    assert dump['children']['settings']['attributes']['frame_gap']['value'] \
+        == hlwm.get_attr('settings.frame_gap')
+
+
+def test_dump_objects_invalid_path(hlwm):
+    hlwm.call_xfail('dump_objects tags.foo') \
+        .expect_stderr('No such object tags.foo')
+
+
+def test_get_attr_repeatedly_after_tree_changes(hlwm):
+    hlwm.call('add othertag')
+    # query the same paths repeatedly while the object tree changes
+    assert hlwm.get_attr('tags.focus.name') == 'default'
+    assert hlwm.get_attr('tags.1.name') == 'othertag'
+    hlwm.call('use othertag')
+    assert hlwm.get_attr('tags.focus.name') == 'othertag'
+    hlwm.call('use default')
+    hlwm.call('merge_tag othertag default')
+    hlwm.call_xfail('get_attr tags.1.name') \
+        .expect_stderr('No such object tags.1')
+    hlwm.call('add newtag')
+    assert hlwm.get_attr('tags.1.name') == 'newtag'
+    hlwm.call('new_attr int tags.1.my_attr 4')
+    hlwm.call('compare tags.1.my_attr = 4')
+    hlwm.call('remove_attr tags.1.my_attr')
+    hlwm.call('new_attr int tags.1.my_attr 5')
+    hlwm.call('compare tags.1.my_attr = 5')
+
+
 def test_getenv_completion(hlwm):
     prefix = 'some_uniq_prefix_'
     name = prefix + 'envname'
@@ -397,6 +492,92 @@ def test_compare_completion(hlwm):
     hlwm.command_has_all_args(['compare', 'tags.count', '=', '23'])
 
 
+@pytest.mark.parametrize("expression,value", [
+    ('1 + 2', '3'),
+    ('10 - 3 - 2', '5'),
+    ('- 4 + 1', '-3'),
+    ('"foo" + \'bar\'', 'foobar'),
+    ('"x" + 3', 'x3'),
+    ('2 < 10', 'true'),
+    ('"2" < "10"', 'true'),
+    ('"b" < "a"', 'false'),
+    ('04 == 4', 'true'),
+    ('3 != 3', 'false'),
+    ('!(1 <= 2)', 'false'),
+    ('true && false || true', 'true'),
+    ('tags.count', '1'),
+    ('tags.count + 1 == 2', 'true'),
+    ('tags.focus.name + "!"', 'default!'),
+])
+def test_expr_values(hlwm, expression, value):
+    proc = hlwm.unchecked_call(['expr', expression])
+    assert proc.stdout == value + '\n'
+    assert proc.returncode == (1 if value in ['false', '0'] else 0)
+
+
+def test_expr_joins_arguments(hlwm):
+    assert hlwm.call('expr tags.count == 1').stdout == 'true\n'
+
+
+def test_expr_exists(hlwm):
+    assert hlwm.call('expr exists(tags.focus)').stdout == 'true\n'
+    assert hlwm.call('expr exists(tags.focus.)').stdout == 'true\n'
+    assert hlwm.call('expr exists(tags.focus.name)').stdout == 'true\n'
+    proc = hlwm.unchecked_call('expr exists(clients.focus)')
+    assert (proc.stdout, proc.returncode) == ('false\n', 1)
+    hlwm.call_xfail_no_output('silent expr exists(tags.nonexistent)')
+
+
+def test_expr_short_circuit(hlwm):
+    # clients.focus.floating does not exist but is not evaluated
+    proc = hlwm.unchecked_call('expr exists(clients.focus) && clients.focus.floating')
+    assert proc.stdout == 'false\n'
+    assert proc.returncode == 1
+    assert hlwm.call('expr 1 || clients.focus.floating').stdout == 'true\n'
+
+
+def test_expr_conditional_command(hlwm):
+    hlwm.call('new_attr string my_str')
+    hlwm.call('and , silent expr tags.count > 1 , set_attr my_str no')
+    hlwm.call('and , silent expr tags.count == 1 , set_attr my_str yes')
+    assert hlwm.get_attr('my_str') == 'yes'
+
+
+@pytest.mark.parametrize("expression,error", [
+    ('tags.nonexistent', 'no such attribute "tags.nonexistent" at position 0'),
+    ('1 +', 'unexpected end of expression'),
+    ('(1', 'expected "\\)" but got end of expression'),
+    ('"foo', 'unterminated string'),
+    ('1 # 2', 'invalid character "#" at position 2'),
+    ('1 2', 'unexpected "2" at position 2'),
+    ('"a" - 1', 'non-numeric operands for "-" at position 4'),
+    ('exists(1)', 'expected an object path'),
+])
+def test_expr_errors(hlwm, expression, error):
+    hlwm.call_xfail(['expr', expression]).expect_stderr(error)
+
+
+@pytest.mark.parametrize("prefix,suffix", [
+    ('!', ''),
+    ('(', ')'),
+    ('-', ''),
+])
+def test_expr_nested_too_deeply(hlwm, prefix, suffix):
+    # a moderate nesting depth is fine
+    hlwm.call(['expr', prefix * 100 + '1' + suffix * 100])
+    # but a very deep one is rejected instead of overflowing the stack
+    depth = 300000
+    hlwm.call_xfail(['expr', prefix * depth + '1' + suffix * depth]) \
+        .expect_stderr('expression nested too deeply')
+    # and hlwm is still alive
+    hlwm.call('true')
+
+
+def test_expr_completion(hlwm):
+    assert 'tags.count ' in hlwm.complete('expr tags.', position=1, partial=True)
+    assert hlwm.unchecked_call('expr').returncode == 9
+
+
 def test_compare_fallback_string_equal(hlwm):
     hlwm.call('set_layout max')
     proc = hlwm.call('compare tags.focus.tiling.root.algorithm = max')
@@ -649,6 +830,19 @@ def test_foreach_clients(hlwm):
     assert expected_out == hlwm.call('foreach C clients echo C').stdout
 
 
+def test_foreach_nested_chain_substitution(hlwm):
+    hlwm.call('add othertag')
+
+    # every iteration substitutes the identifier in the original command
+    cmd = 'foreach T tags.by-name. chain , echo T , and . echo T . sprintf S %s T.name echo S'
+    proc = hlwm.call(cmd)
+
+    assert proc.stdout.splitlines() == [
+        'tags.by-name.default', 'tags.by-name.default', 'default',
+        'tags.by-name.othertag', 'tags.by-name.othertag', 'othertag',
+    ]
+
+
 def test_foreach_tag_add(hlwm):
     hlwm.call('add anothertag')
 
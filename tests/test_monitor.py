@@ -1,5 +1,8 @@
 import pytest
+import time
 from herbstluftwm.types import Rectangle
+from Xlib import X
+import Xlib
 
 
 def test_default_monitor(hlwm):
@@ -311,6 +314,69 @@ def test_set_monitors_removes_monitors(hlwm, monitor_count_before):
     assert monitors == '0: 100x200+100+0 with tag "default" [FOCUS]\n'
 
 
+def test_set_monitors_applies_layout_of_changed_monitors(hlwm, x11):
+    hlwm.call('add tag2')
+    hlwm.call('set_monitors 400x300+0+0 400x300+400+0')
+    winhandles = []
+    for tag in ['default', 'tag2']:
+        hlwm.call(f'rule once tag={tag}')
+        winhandle, winid = x11.create_client()
+        hlwm.attr.clients[winid].fullscreen = 'on'
+        winhandle.change_attributes(event_mask=X.StructureNotifyMask)
+        winhandles.append(winhandle)
+    x11.sync_with_hlwm()
+    x11.pop_pending_events()
+
+    rects = ['400x300+0+0', '500x200+400+0']
+    hlwm.call(['set_monitors'] + rects)
+
+    x11.sync_with_hlwm()
+    configured = [e.window.id for e in x11.pop_pending_events()
+                  if e.type == X.ConfigureNotify]
+    # only the client on the changed monitor was resized
+    assert winhandles[0].id not in configured
+    assert winhandles[1].id in configured
+    for winhandle, rect in zip(winhandles, rects):
+        geom = x11.get_absolute_geometry(winhandle)
+        assert '%dx%d%+d%+d' % (geom.width, geom.height, geom.x, geom.y) == rect
+
+
+def test_auto_detect_monitors_coalesces_changes(hlwm, hc_idle, x11):
+    detected_count = len(hlwm.call('detect_monitors --list').stdout.splitlines())
+    assert detected_count != 2
+    hlwm.attr.settings.monitor_detection_delay = 1000
+    hlwm.attr.settings.auto_detect_monitors = True
+    hlwm.call('add tag2')
+    hlwm.call('add tag3')
+    hlwm.call('set_monitors 400x300+0+0 400x300+400+0')
+    hlwm.call('watch monitors.count')
+
+    def send_root_configure_notify_events():
+        geom = x11.root.get_geometry()
+        for _ in range(5):
+            event = Xlib.protocol.event.ConfigureNotify(
+                window=x11.root, event=x11.root, above_sibling=X.NONE,
+                x=0, y=0, width=geom.width, height=geom.height,
+                border_width=0, override=False)
+            x11.root.send_event(event, event_mask=X.StructureNotifyMask)
+        x11.sync_with_hlwm()
+
+    send_root_configure_notify_events()
+    # the monitors are not detected right away, so they can still be changed
+    hlwm.call('set_monitors 400x300+0+0 400x300+400+0 400x300+800+0')
+    send_root_configure_notify_events()
+    hlwm.call('set_monitors 400x300+0+0 400x300+400+0')
+    # then all events are handled by a single detection
+    time.sleep(1.5)
+
+    changes = [h for h in hc_idle.hooks() if h[0] == 'attribute_changed']
+    assert changes == [
+        ['attribute_changed', 'monitors.count', '2', '3'],
+        ['attribute_changed', 'monitors.count', '3', '2'],
+        ['attribute_changed', 'monitors.count', '2', str(detected_count)],
+    ]
+
+
 def test_raise_monitor_completion(hlwm):
     hlwm.call('add tag2')
     hlwm.call('add_monitor 800x600+40+40 tag2 monitor2')
@@ -60,6 +60,16 @@ def test_attr_set_dict_custom_attribute(hlwm):
     assert hlwm.call('get_attr monitors.0.my_test').stdout == 'value'
 
 
+def test_get_attrs(hlwm):
+    hlwm.attr.my_str = 'multi\nline\twith \\ escapes'
+
+    values = hlwm.get_attrs(['my_str', 'tags.focus.'])
+
+    assert values['my_str'] == 'multi\nline\twith \\ escapes'
+    assert values['tags.focus.name'] == 'default'
+    assert values['tags.focus.index'] == '0'
+
+
 @pytest.mark.parametrize('value', ['a', 'b', 'c'])
 def test_chain_commands_if_then_else(hlwm, value):
     from herbstluftwm import chain
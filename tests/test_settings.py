@@ -14,6 +14,7 @@ SMART_FRAME_SURROUNDINGS = {
 
 can_toggle = [
     'update_dragged_clients',
+    'decoration_resize_windows',
 ]
 
 cannot_toggle = [
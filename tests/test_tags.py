@@ -57,6 +57,35 @@ def test_use_previous(hlwm):
     assert hlwm.get_attr('tags.focus.index') == '1'
 
 
+def test_use_previous_applies_changes_of_hidden_tag(hlwm):
+    hlwm.call('add foobar')
+    winid, _ = hlwm.create_client()
+    geometry = hlwm.attr.clients[winid].content_geometry()
+    hlwm.call('use foobar')
+    hlwm.call('use_previous')
+    # switching back without changes keeps the geometry
+    assert hlwm.attr.clients[winid].content_geometry() == geometry
+
+    hlwm.call('use foobar')
+    hlwm.attr.settings.window_gap = hlwm.attr.settings.window_gap() + 20
+    hlwm.call('use_previous')
+
+    # the change of the hidden tag was applied
+    assert hlwm.attr.clients[winid].content_geometry() != geometry
+
+
+def test_use_previous_applies_floating_geometry_of_hidden_tag(hlwm):
+    hlwm.call('add foobar')
+    hlwm.attr.tags.focus.floating = True
+    winid, _ = hlwm.create_client()
+    hlwm.call('use foobar')
+    hlwm.attr.clients[winid].floating_geometry = '300x200+40+50'
+    hlwm.call('use_previous')
+
+    geometry = hlwm.attr.clients[winid].content_geometry()
+    assert (geometry.width, geometry.height) == (300, 200)
+
+
 @pytest.mark.parametrize("running_clients_num", [0, 1, 5])
 def test_new_clients_increase_client_count(hlwm, running_clients, running_clients_num):
     assert hlwm.get_attr('tags.0.client_count') == str(running_clients_num)
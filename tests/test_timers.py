@@ -0,0 +1,69 @@
+import time
+
+
+def test_timers_count(hlwm):
+    assert hlwm.attr.timers.count() == 0
+    hlwm.call('timer mytimer 100000 true')
+    assert hlwm.attr.timers.count() == 1
+    # a timer with the same label is replaced
+    hlwm.call('timer mytimer 100000 false')
+    assert hlwm.attr.timers.count() == 1
+    hlwm.call('timer othertimer 100000 true')
+    assert hlwm.attr.timers.count() == 2
+
+    hlwm.call('untimer mytimer')
+    assert hlwm.attr.timers.count() == 1
+    hlwm.call('untimer --all')
+    assert hlwm.attr.timers.count() == 0
+
+
+def test_timer_runs_once(hlwm, hc_idle):
+    hlwm.call('timer mytimer 100 emit_hook timer_fired')
+
+    assert hc_idle.read_hook() == ['timer_fired']
+    assert hlwm.attr.timers.count() == 0
+
+
+def test_timer_periodic(hlwm, hc_idle):
+    hlwm.call('timer --periodic mytimer 50 emit_hook tick')
+
+    for _ in range(3):
+        assert hc_idle.read_hook() == ['tick']
+    assert hlwm.attr.timers.count() == 1
+    hlwm.call('untimer mytimer')
+    assert hlwm.attr.timers.count() == 0
+
+
+def test_timer_removes_itself(hlwm, hc_idle):
+    hlwm.call('timer --periodic mytimer 50 chain , emit_hook tick , untimer mytimer')
+
+    assert hc_idle.read_hook() == ['tick']
+    time.sleep(0.2)
+    assert hc_idle.hooks() == []
+    assert hlwm.attr.timers.count() == 0
+
+
+def test_untimer_removes_before_running(hlwm, hc_idle):
+    hlwm.call('timer mytimer 200 emit_hook timer_fired')
+    hlwm.call('untimer mytimer')
+
+    time.sleep(0.4)
+    assert hc_idle.hooks() == []
+
+
+def test_timer_invalid_arguments(hlwm):
+    hlwm.call_xfail('timer --periodic mytimer 0 true') \
+        .expect_stderr('interval of a periodic timer must be positive')
+    hlwm.call_xfail(['timer', '', '100', 'true']) \
+        .expect_stderr('label must not be empty')
+    hlwm.call_xfail('untimer nosuchtimer') \
+        .expect_stderr('no timer with label "nosuchtimer"')
+    assert hlwm.unchecked_call('timer mytimer 100').returncode == 9
+    assert hlwm.attr.timers.count() == 0
+
+
+def test_untimer_completion(hlwm):
+    hlwm.call('timer foo 100000 true')
+    hlwm.call('timer bar 100000 true')
+
+    assert hlwm.complete('untimer') == sorted(['-F', '--all', 'foo', 'bar'])